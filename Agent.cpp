@@ -10,231 +10,89 @@
 
 using namespace std;
 
-extern GameData* gameData;
+Agent *std::resolveAgent(const EntityStore *store, const EntityHandle &h)
+{
+	return static_cast<Agent *>(store->resolve(h));
+}
 
-void Agent::glVectorT(Vector v)
+Agent *Agent::getMaisProximo() const
 {
-	glVertex3f(v.getX(),v.getY(),v.getZ());
+	Agent *a = resolveAgent(getStore(), getStore()->maisProximo[getSlot()]);
+	return a != NULL && !a->isToDestroy() ? a : NULL;
 }
 
-void Agent::desenhaRadar()
+Agent *Agent::findMaisProximo(const GameData *mundo)
 {
-	double size = 1.0/16;
-	if(maisProximo == NULL) return;
-	Vector direcaoMaisProx = maisProximo->getPosition() - position;
-	double seno = dir.crossProduct(direcaoMaisProx).getLengthVector();
-	double cosseno = dir.dotProduct(direcaoMaisProx);
-
-	double phi;
-	if(cosseno == 0) phi = M_PI/2;
-	else phi = atan2(seno,cosseno);
-
-
-	glTranslated(position.getX(),position.getY(),position.getZ()+0.2);
-
-	Vector local_dir = dir;
-	Vector local_side = side;
-	Vector local_up = up;
-
-	local_dir = dir.rotateVector(up,phi).setVectorLength(1.0);
-	local_side = up.crossProduct(dir);
-
-	glBegin(GL_TRIANGLES);
-	glVectorT(local_dir*2*size);
-	glVectorT(local_side*(-size/2)-local_up*(size/5));
-	glVectorT(local_side*(size/2)-local_up*(size/5));
-	glEnd();
-
-	glBegin(GL_TRIANGLES);
-	glVectorT(local_dir*2*size);
-	glVectorT(local_side*(-size/2)+local_up*(size/5));
-	glVectorT(local_side*(size/2)+local_up*(size/5));
-	glEnd();
-
-	glBegin(GL_QUADS);
-		glVectorT(local_side*(-size/2)+local_up*(size/5));
-		glVectorT(local_side*(size/2)+local_up*(size/5));
-		glVectorT(local_side*(size/2)-local_up*(size/5));
-		glVectorT(local_side*(-size/2)-local_up*(size/5));
-	glEnd();
-
-	glTranslated(-position.getX(),-position.getY(),-position.getZ()-0.2);
-	//glRotatef(-phi*180/M_PI,0,0,1);
+	EntityStore *s = getStore();
+	int slot = getSlot();
+	int agora = (int) mundo->getIteracao();
+	if(s->iteracaoMaisProximo[slot] != agora)
+	{
+		Agent *alvo = mundo->getGrid()->nearest(getPosition(), RADAR_MAX_DIST, this, getId());
+		s->maisProximo[slot] = alvo ? alvo->getHandle() : nullHandle();
+		s->iteracaoMaisProximo[slot] = agora;
+	}
+	return getMaisProximo();
 }
 
-Agent::Agent()
+void Agent::setRadar(bool ligado)
 {
-	maisProximo = NULL;
-	id = 0;
-	destroy = false;
-	recarga = 0;
-	position = Vector(0,0,0);
-	velocity = Vector(-2,0,0); // Evita problema de inicialização na camera (GAMB, POG).
-
-	dir = Vector(1,0,0);
-	side = Vector(0,1,0);
-	up = Vector(0,0,1);
-	disparando = false;
+	radar = ligado;
 }
 
-Agent::Agent(Vector pos)
+Agent::Agent(EntityStore *store, Vector pos, int type) : Controlable(store, pos, type)
 {
-	maisProximo = NULL;
-	id = 0;
+	radar = false;
 	destroy = false;
-	recarga = 0;
-	position = pos;
-	velocity = Vector(-2,0,0); // Evita problema de inicialização na camera (GAMB, POG).
-
-	dir = Vector(1,0,0);
-	side = Vector(0,1,0);
-	up = Vector(0,0,1);
-	disparando = false;
+	setVelocity(Vector(-2,0,0)); // Evita problema de inicialização na camera (GAMB, POG).
 
 }
 
 void Agent::setId(int idx)
 {
-	id = idx;
+	setTeam(idx);
 }
 
 int Agent::getId()
 {
-	return id;
+	return getTeam();
 }
 
-void glNormalT(Vector v)
+void Agent::beginThink(const GameData *mundo)
 {
-	glNormal3f(v.getX(),v.getY(),v.getZ());
+	if(radar) findMaisProximo(mundo);
+	getStore()->recarga[getSlot()]++;
 }
 
- void Agent::draw()
+void Agent::think(const GameData *mundo)
 {
-		double size = 1/8.0;
-		Vector dirl = dir*size*(1+sqrt(5))/2.0; // Razão de ouro!
-		Vector sidel = side*size;
-		Vector upl = up*size;
-
-
-
-		//glColor4f(1,1,1,0);
-
-
-
-		Vector P1 = dirl - sidel;
-		Vector P2 = P1 + upl;
-		Vector P3 = P2 + sidel * 2;
-		Vector P4 = P3 - upl;
-
-		Vector P5 = P1 - dirl * 2;
-		Vector P6 = P2 - dirl * 2;
-		Vector P7 = P3 - dirl * 2;
-		Vector P8 = P4 - dirl * 2;
-
-		// Ajustes para caber na textura.
-		P5 = P5 + dirl*0.23;
-		P8 = P8 + dirl*0.23;
-
-//		char t0[20] = "frente.bmp";
-//		char t1[20] = "verso.bmp";
-//		char t2[20] = "lateralDir.bmp";
-//		char t3[20] = "lateralEsq.bmp";
-//		char t4[20] = "frente.bmp""topo.bmp";
-//
-
-
-
-		glColor3f(0.2,0.7,0.1);
-
-		if(id == PLAYER_ID)
-		desenhaRadar();
-
-		glTranslatef(position.getX(),position.getY(),position.getZ());
-
-
-
-
-		// Fazendo a frente do tanque.
-		glBindTexture(GL_TEXTURE_2D, tanque[0]);
-		glBegin(GL_QUADS);
-			glNormalT(dir);
-			glTexCoord2f(0.0f, 0.0f); glVectorT(P1);
-			glTexCoord2f(1.0f, 0.0f); glVectorT(P4);
-			glTexCoord2f(1.0f, 1.0f); glVectorT(P3);
-			glTexCoord2f(0.0f, 1.0f); glVectorT(P2);
-		glEnd();
-
-
-		// Fazendo o verso do tanque.
-		glBindTexture(GL_TEXTURE_2D, tanque[1]);
-		glBegin(GL_QUADS);
-			glNormalT(dir*(-1.0));
-			glTexCoord2f(0.0f, 0.0f); glVectorT(P5);
-			glTexCoord2f(1.0f, 0.0f); glVectorT(P8);
-			glTexCoord2f(1.0f, 1.0f); glVectorT(P7);
-			glTexCoord2f(0.0f, 1.0f); glVectorT(P6);
-		glEnd();
-
-
-
-		// Fazendo a lateral direita do tanque.
-		glBindTexture(GL_TEXTURE_2D, tanque[2]);
-		glBegin(GL_QUADS);
-			glNormalT(side*(-1.0));
-			glTexCoord2f(0.15f, 0.0f); glVectorT(P5);
-			glTexCoord2f(1.0f-0.06f, 0.0f); glVectorT(P1);
-			glTexCoord2f(1.0f, 1.0f); glVectorT(P2);
-			glTexCoord2f(0.0f, 1.0f); glVectorT(P6);
-		glEnd();
-
-		// Fazendo a lateral esquerda do tanque.
-		glBindTexture(GL_TEXTURE_2D, tanque[3]);
-		glBegin(GL_QUADS);
-			glNormalT(side);
-			glTexCoord2f(0.06f, 0.0f); glVectorT(P4);
-			glTexCoord2f(1.0f-0.15f, 0.0f); glVectorT(P8);
-			glTexCoord2f(1.0f, 1.0f); glVectorT(P7);
-			glTexCoord2f(0.0f, 1.0f); glVectorT(P3);
-		glEnd();
-
-
-		// Fazendo o topo do tanque.
-		glBindTexture(GL_TEXTURE_2D, tanque[4]);
-		glBegin(GL_QUADS);
-			glNormalT(up);
-			glTexCoord2f(0.0f, 0.0f); glVectorT(P6);
-			glTexCoord2f(1.0f, 0.0f); glVectorT(P2);
-			glTexCoord2f(1.0f, 1.0f); glVectorT(P3);
-			glTexCoord2f(0.0f, 1.0f); glVectorT(P7);
-		glEnd();
-
-
-		glTranslatef(-position.getX(),-position.getY(),-position.getZ());
+	beginThink(mundo);
+	Agent::controlAction();
+	// A integracao acontece depois, em lote, no EntityStore.
 }
 
-void Agent::iterate()
+void Agent::iterate(const GameData *mundo)
 {
+	think(mundo);
+}
 
+void Agent::saveEstado(AgentEstado &e) const
+{
+	Agent *proximo = getMaisProximo();
+	e.recarga = getRecarga();
+	e.maisProximo = proximo ? proximo->getSlot() : -1;
+	e.destruir = destroy;
+	e.radar = radar;
+}
 
-	double dist = 1000;
-	double menor_dist = dist;
-	for(int i = 0; i < gameData->getQuant(); i++)
-	{
-		Agent *ai = gameData->getAgents()[i];
-		dist = (ai->getPosition() - position).getLengthVector();
-		if(dist < menor_dist && ai->getId() != PLAYER_ID)
-		{
-			Projetil *j = dynamic_cast <Projetil *>(ai);
-			if(j == NULL)
-			maisProximo = ai;
-		}
-	}
-//	if(id == PLAYER_ID)
-//	cout << maisProximo->getId() << "\n";
-
-	recarga++;
-	controlAction();
-	Controlable::iterate();
+void Agent::restoreEstado(const AgentEstado &e)
+{
+	EntityStore *s = getStore();
+	s->recarga[getSlot()] = e.recarga;
+	s->maisProximo[getSlot()] = e.maisProximo >= 0 ? s->getBody(e.maisProximo)->getHandle() : nullHandle();
+	s->iteracaoMaisProximo[getSlot()] = -1;
+	destroy = e.destruir;
+	radar = e.radar;
 }
 
 void Agent::controlAction()
@@ -243,31 +101,32 @@ void Agent::controlAction()
 
 	double vert = 0, hor = 0;
 
-	if(control->arrowUp) vert += 1;
+	if(control->arrowUp || control->joypad[JOYPAD_UP]) vert += 1;
 
-	if(control->arrowDown) vert -= 1;
+	if(control->arrowDown || control->joypad[JOYPAD_DOWN]) vert -= 1;
 
-	if(control->arrowRight) hor += 1;
+	if(control->arrowRight || control->joypad[JOYPAD_RIGHT]) hor += 1;
 
-	if(control->arrowLeft) hor -= 1;
+	if(control->arrowLeft || control->joypad[JOYPAD_LEFT]) hor -= 1;
 
-	Vector nDir = dir;
+	Vector nDir = getDir();
 
-	if(control->space) atirar();
+	if(control->space || control->joypad[JOYPAD_FIRE]) Agent::atirar();
 
-	aceleration = nDir.setVectorLength(MOVABLE_MAX_ACCELERATION) * vert; // O tanque sempre vai na direção oposta ao motor (portanto dir).
+	setAcelerration(nDir.setVectorLength(MOVABLE_MAX_ACCELERATION) * vert); // O tanque sempre vai na direção oposta ao motor (portanto dir).
 
-	v_yaw = -hor;
+	setVYaw(-hor);
 
 
 }
 
 void Agent::atirar()
 {
-	if(recarga > ROUNDS_RECARGA)
+	EntityStore *s = getStore();
+	if(s->recarga[getSlot()] > ROUNDS_RECARGA)
 	{
-		recarga = 0;
-		disparando = true;
+		s->recarga[getSlot()] = 0;
+		s->disparando[getSlot()] = true;
 	}
 }
 
@@ -283,6 +142,7 @@ bool Agent::isToDestroy()
 
 bool Agent::checkDisparo()
 {
+	unsigned char &disparando = getStore()->disparando[getSlot()];
 	if(disparando)
 	{
 		disparando = false;
@@ -291,5 +151,21 @@ bool Agent::checkDisparo()
 	else return false;
 }
 
+Pool &Agent::pool()
+{
+	static Pool p(sizeof(Agent));
+	return p;
+}
+
+void *Agent::operator new(size_t size)
+{
+	return pool().allocate(size);
+}
+
+void Agent::operator delete(void *p)
+{
+	pool().release(p);
+}
+
 Agent::~Agent() {
 }
@@ -9,43 +9,64 @@
 #define AGENT_H_
 
 #include "Movable.h"
-#include "oDrawable.h"
-#include "Matter.h"
 #include "Controlable.h"
+#include "Pool.h"
+#include "WorldFile.h"
 
-extern GLuint tanque[5];
-
+class GameData;
 
 namespace std {
 
-class Agent : public Controlable, public oDrawable, public Matter{
+class Agent : public Controlable {
 private:
-	int id;
+	// Recarga, disparo pendente e alvo mais proximo sao lidos em todo think e
+	// ficam em colunas do EntityStore; aqui so o que quase nunca muda.
 	bool destroy;
+	bool radar;
+protected:
+	// O que todo tanque faz antes de decidir: radar e recarga.
+	void beginThink(const GameData *mundo);
 public:
-	bool disparando;
-	int recarga;
-	Agent *maisProximo;
-
-	Agent();
-	Agent(Vector x);
+	Agent(EntityStore *store, Vector x, int type = ENTITY_TANK);
 	void setId(int idx);
 	int getId();
-	void desenhaRadar();
-	void draw();
+	// Procura o alvo mais proximo em toda iteracao, mesmo sem ninguem pedir (o radar
+	// do jogador, que o desenho le). Desligado por padrao.
+	void setRadar(bool ligado);
+	// Alvo mais proximo de outro time nesta iteracao de 'mundo'. Calculado na primeira chamada e
+	// guardado ate a iteracao seguinte; so vale na fase de decisao, com a grade atual.
+	Agent *findMaisProximo(const GameData *mundo);
+	// O ultimo resultado de findMaisProximo(), ou NULL se ele ja nao existe.
+	Agent *getMaisProximo() const;
 	void controlAction();
 
 	virtual void atirar();
 	bool checkDisparo();
+	int getRecarga() const { return getStore()->recarga[getSlot()]; }
 
 	void destroyNow();
 	bool isToDestroy();
-	void iterate();
-	void glVectorT(Vector v);
+	// O mundo vem por parametro, nunca de um global: varios GameData podem rodar
+	// no mesmo processo. think() nao e virtual: o GameData chama a de cada tipo
+	// pelo tag do EntityStore; iterate() e para quem so tem um Agent *.
+	void think(const GameData *mundo);
+	virtual void iterate(const GameData *mundo);
+
+	// O estado que nao esta nas colunas do EntityStore, para gravar o mundo. So
+	// no fim de uma iteracao; restoreEstado() depois que todos os corpos existem.
+	void saveEstado(AgentEstado &e) const;
+	void restoreEstado(const AgentEstado &e);
+
+	// Agentes (e cada subclasse) vem de um Pool proprio, reciclado na destruicao.
+	static Pool &pool();
+	static void *operator new(size_t size);
+	static void operator delete(void *p);
+
 	~Agent();
 };
 
-void glVectorT(Vector v);
+// Todo corpo do EntityStore e um Agent.
+Agent *resolveAgent(const EntityStore *store, const EntityHandle &h);
 
 
 } /* namespace std */
@@ -0,0 +1,85 @@
+/*
+ * AssetLoader.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "AssetLoader.h"
+#include "ThreadPool.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+AssetLoader::AssetLoader()
+{
+	enviados = 0;
+	threads = 0;
+}
+
+void AssetLoader::add(AssetDecode decode, AssetUpload upload, void *ctx)
+{
+	Job j;
+	j.decode = decode;
+	j.upload = upload;
+	j.ctx = ctx;
+	jobs.push_back(j);
+}
+
+void AssetLoader::decodeTask(int begin, int end, int /*worker*/, void *ctx)
+{
+	AssetLoader *l = (AssetLoader *) ctx;
+	for(int i = begin; i < end; i++)
+	{
+		bool ok = l->jobs[i].decode(l->jobs[i].ctx);
+
+		std::lock_guard<std::mutex> lock(l->m);
+		if(ok) l->prontos.push_back(i);
+		else l->falhas.push_back(i);
+	}
+}
+
+void AssetLoader::run()
+{
+	// Um recurso por vez para cada thread: os arquivos tem tamanhos muito diferentes.
+	ThreadPool pool(threads);
+	pool.parallelFor((int) jobs.size(), 1, decodeTask, this);
+}
+
+void AssetLoader::start(int threads_)
+{
+	threads = threads_;
+	carregador = std::thread(&AssetLoader::run, this);
+}
+
+bool AssetLoader::uploadReady()
+{
+	std::vector<int> agora;
+	{
+		std::lock_guard<std::mutex> lock(m);
+		if(!falhas.empty())
+		{
+			exit(1);
+		}
+		agora.swap(prontos);
+	}
+
+	for(unsigned int i = 0; i < agora.size(); i++)
+	{
+		jobs[agora[i]].upload(jobs[agora[i]].ctx);
+	}
+	enviados += (int) agora.size();
+
+	if(enviados == (int) jobs.size() && carregador.joinable())
+	{
+		carregador.join();
+	}
+	return enviados == (int) jobs.size();
+}
+
+AssetLoader::~AssetLoader()
+{
+	if(carregador.joinable())
+	{
+		carregador.join();
+	}
+}
@@ -0,0 +1,65 @@
+/*
+ * AssetLoader.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef ASSETLOADER_H_
+#define ASSETLOADER_H_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+
+// Decodifica o recurso (ler arquivo, converter pixels). Roda em uma thread do
+// carregador, entao nao pode chamar GL. Falso se falhou.
+typedef bool (*AssetDecode)(void *ctx);
+// Envia o recurso ja decodificado para o GL. Roda na thread do GL.
+typedef void (*AssetUpload)(void *ctx);
+
+// Carrega os recursos do jogo em paralelo enquanto a janela ja desenha. As
+// decodificacoes rodam em um ThreadPool proprio, em uma thread separada, e cada
+// uma que termina entra em uma fila; a thread do GL chama uploadReady() a cada
+// quadro para subir o que ja ficou pronto. Ate la quem desenha usa o que quiser
+// como substituto (as texturas ficam com uma cor so).
+class AssetLoader {
+private:
+	typedef struct Job {
+		AssetDecode decode;
+		AssetUpload upload;
+		void *ctx;
+	} Job;
+
+	std::vector<Job> jobs;
+	std::vector<int> prontos; // Indices ja decodificados e ainda nao enviados.
+	std::vector<int> falhas;
+	int enviados;
+	std::mutex m;
+	std::thread carregador;
+	int threads;
+
+	static void decodeTask(int begin, int end, int worker, void *ctx);
+	void run();
+
+	AssetLoader(const AssetLoader &);
+	AssetLoader &operator=(const AssetLoader &);
+
+public:
+	AssetLoader();
+
+	// Registra um recurso. So vale antes de start().
+	void add(AssetDecode decode, AssetUpload upload, void *ctx);
+
+	// Comeca a decodificar tudo com 'threads' threads (<= 0 usa todos os nucleos).
+	void start(int threads_);
+
+	// Thread do GL: envia os recursos que ja foram decodificados. Sai do programa
+	// se algum nao pode ser lido, como o carregamento direto sempre fez.
+	// Verdadeiro quando nao falta mais nada.
+	bool uploadReady();
+
+	~AssetLoader();
+};
+
+#endif /* ASSETLOADER_H_ */
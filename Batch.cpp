@@ -0,0 +1,128 @@
+/*
+ * Batch.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "GameData.h"
+#include "ThreadPool.h"
+#include "Timer.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Partidas robo contra robo sem janela e sem tempo real, para ajustar a IA e o
+// balanceamento: o jogador e um Enemy cacador contra 'inimigos' Enemy normais.
+// Cada partida e um GameData proprio, de uma thread so, e as threads do lote
+// pegam a proxima partida livre assim que terminam a sua (pedacos de uma
+// partida), entao partidas longas nao deixam ninguem parado.
+
+typedef struct ResultadoPartida {
+	unsigned int semente;
+	int estado;        // JOGO_*; JOGO_ANDAMENTO se bateu no limite de iteracoes.
+	int iteracoes;
+	long disparos;
+	int sobreviventes; // Inimigos vivos no fim.
+} ResultadoPartida;
+
+typedef struct Lote {
+	int inimigos;
+	int maxIteracoes;
+	unsigned int semente;
+	std::vector<ResultadoPartida> resultados;
+} Lote;
+
+static void partidaTask(int begin, int end, int /*worker*/, void *ctx)
+{
+	Lote *lote = (Lote *) ctx;
+	for(int i = begin; i < end; i++)
+	{
+		ResultadoPartida &r = lote->resultados[i];
+		r.semente = lote->semente + i;
+
+		GameData jogo(lote->inimigos, 1, r.semente, true);
+		jogo.setSilencioso(true);
+		int t = 0;
+		while(t < lote->maxIteracoes && jogo.getEstadoJogo() == JOGO_ANDAMENTO)
+		{
+			jogo.iterateGameData();
+			t++;
+		}
+
+		r.estado = jogo.getEstadoJogo();
+		r.iteracoes = t;
+		r.disparos = jogo.getTiros()->getDisparos();
+		r.sobreviventes = jogo.getQuant() - 1; // O jogador fica no EntityStore mesmo destruido.
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int partidas = 1000;
+	int threads = 0;
+	const char *saida = NULL;
+	Lote lote;
+	// Com 2 inimigos o cacador ganha, perde e empata em proporcoes que dizem algo
+	// (com 10 ele perde todas); quem nao acaba em 5000 iteracoes nao acaba mais.
+	lote.inimigos = 2;
+	lote.maxIteracoes = 5000;
+	lote.semente = 1;
+
+	// Uso: ./jogoThaylo-batch [--matches N] [--enemies E] [--seed S] [--threads T]
+	//                          [--max-ticks M] [--out ARQUIVO.csv]
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i], "--matches") == 0 && i + 1 < argc)
+			partidas = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--enemies") == 0 && i + 1 < argc)
+			lote.inimigos = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+			lote.semente = strtoul(argv[++i], NULL, 10);
+		else if(strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--max-ticks") == 0 && i + 1 < argc)
+			lote.maxIteracoes = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+			saida = argv[++i];
+		else
+		{
+			fprintf(stderr, "opcao desconhecida: %s\n", argv[i]);
+			return 1;
+		}
+	}
+	if(partidas < 1) partidas = 1;
+
+	FILE *csv = stdout;
+	if(saida != NULL && (csv = fopen(saida, "w")) == NULL)
+	{
+		perror(saida);
+		return 1;
+	}
+
+	lote.resultados.resize(partidas);
+	ThreadPool pool(threads);
+
+	long long inicio = getMonotonicTime();
+	pool.parallelFor(partidas, 1, partidaTask, &lote);
+	double total = (getMonotonicTime() - inicio) / 1e9;
+
+	// O CSV so depende das sementes, nao das threads nem da ordem em que as
+	// partidas terminaram.
+	const char *estados[] = { "limite", "derrota", "vitoria" };
+	int contagem[3] = { 0, 0, 0 };
+	fprintf(csv, "partida,semente,resultado,iteracoes,disparos,sobreviventes\n");
+	for(int i = 0; i < partidas; i++)
+	{
+		const ResultadoPartida &r = lote.resultados[i];
+		fprintf(csv, "%d,%u,%s,%d,%ld,%d\n", i, r.semente, estados[r.estado], r.iteracoes, r.disparos, r.sobreviventes);
+		contagem[r.estado]++;
+	}
+	if(csv != stdout) fclose(csv);
+
+	fprintf(stderr, "%d partidas de %d inimigos em %.2f s com %d threads (%.1f partidas/s): "
+			"%d vitorias, %d derrotas, %d no limite\n",
+			partidas, lote.inimigos, total, pool.getThreads(), partidas/total,
+			contagem[JOGO_VITORIA], contagem[JOGO_DERROTA], contagem[JOGO_ANDAMENTO]);
+	return 0;
+}
@@ -0,0 +1,329 @@
+/*
+ * BatchRenderer.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#define GL_GLEXT_PROTOTYPES // glGenBuffers e cia. (GL 1.5).
+
+#include "BatchRenderer.h"
+
+#define FLOATS_TANQUE 8    // T2F_N3F_V3F
+#define FLOATS_TRIANGULO 6 // C3F_V3F
+
+// Cada face fica no atlas cercada por uma borda de 1 texel copiada da propria
+// face, para o filtro linear nao misturar faces vizinhas.
+#define ATLAS_BORDA 1
+
+static const char *facesTanque[TANK_FACES] = {
+	"frente.bmp", "verso.bmp", "lateralDir.bmp", "lateralEsq.bmp", "topo.bmp"
+};
+
+BatchRenderer::BatchRenderer()
+{
+	pronto = false;
+	atlas = 0;
+	buffers[0] = buffers[1] = 0;
+	facesLidas = 0;
+	atlasLargura = atlasAltura = 0;
+}
+
+void BatchRenderer::createBuffers()
+{
+	glGenTextures(1, &atlas);
+	glGenBuffers(2, buffers);
+	pronto = true;
+}
+
+// Sem carregador: le as faces e monta o atlas aqui mesmo.
+void BatchRenderer::init()
+{
+	createBuffers();
+	for(int i = 0; i < TANK_FACES; i++)
+	{
+		if(!ImageLoad((char *) facesTanque[i], &faces[i]))
+		{
+			exit(1);
+		}
+	}
+	composeAtlas();
+	uploadAtlas();
+}
+
+void BatchRenderer::load(AssetLoader *assets)
+{
+	createBuffers();
+	placeholderTexture(atlas);
+	for(int i = 0; i < TANK_FACES; i++)
+	{
+		// O substituto tem uma cor so, qualquer coordenada serve.
+		faceRect[i][0] = faceRect[i][1] = 0;
+		faceRect[i][2] = faceRect[i][3] = 1;
+
+		faceJobs[i].r = this;
+		faceJobs[i].face = i;
+		faceJobs[i].montou = false;
+		assets->add(decodeFace, uploadFace, &faceJobs[i]);
+	}
+}
+
+// Thread do carregador: le uma face, e a ultima a chegar monta o atlas.
+bool BatchRenderer::decodeFace(void *ctx)
+{
+	FaceJob *job = (FaceJob *) ctx;
+	BatchRenderer *r = job->r;
+	if(!ImageLoad((char *) facesTanque[job->face], &r->faces[job->face]))
+	{
+		return false;
+	}
+	if(++r->facesLidas == TANK_FACES)
+	{
+		r->composeAtlas();
+		job->montou = true;
+	}
+	return true;
+}
+
+void BatchRenderer::uploadFace(void *ctx)
+{
+	FaceJob *job = (FaceJob *) ctx;
+	if(job->montou) job->r->uploadAtlas();
+}
+
+// Empilha as cinco faces, de baixo para cima, em uma imagem so. Nao usa GL.
+void BatchRenderer::composeAtlas()
+{
+	unsigned long largura = 0, altura = 0;
+
+	for(int i = 0; i < TANK_FACES; i++)
+	{
+		if(faces[i].sizeX + 2*ATLAS_BORDA > largura) largura = faces[i].sizeX + 2*ATLAS_BORDA;
+		altura += faces[i].sizeY + 2*ATLAS_BORDA;
+	}
+
+	std::vector<unsigned char> pixels(largura*altura*3, 0);
+	unsigned long y0 = 0;
+	for(int i = 0; i < TANK_FACES; i++)
+	{
+		long w = faces[i].sizeX, h = faces[i].sizeY;
+		for(long y = -ATLAS_BORDA; y < h + ATLAS_BORDA; y++)
+		{
+			long ys = y < 0 ? 0 : (y >= h ? h - 1 : y);
+			unsigned char *linha = &pixels[(y0 + ATLAS_BORDA + y)*largura*3];
+			for(long x = -ATLAS_BORDA; x < w + ATLAS_BORDA; x++)
+			{
+				long xs = x < 0 ? 0 : (x >= w ? w - 1 : x);
+				const char *src = faces[i].data + (ys*w + xs)*3;
+				unsigned char *dst = linha + (ATLAS_BORDA + x)*3;
+				dst[0] = src[0];
+				dst[1] = src[1];
+				dst[2] = src[2];
+			}
+		}
+
+		atlasRect[i][0] = (float) ATLAS_BORDA / largura;
+		atlasRect[i][1] = (float) (y0 + ATLAS_BORDA) / altura;
+		atlasRect[i][2] = (float) w / largura;
+		atlasRect[i][3] = (float) h / altura;
+
+		y0 += h + 2*ATLAS_BORDA;
+		free(faces[i].data);
+		faces[i].data = NULL;
+	}
+
+	atlasPixels.swap(pixels);
+	atlasLargura = largura;
+	atlasAltura = altura;
+}
+
+void BatchRenderer::uploadAtlas()
+{
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, 3, atlasLargura, atlasAltura, 0, GL_RGB, GL_UNSIGNED_BYTE, &atlasPixels[0]);
+
+	memcpy(faceRect, atlasRect, sizeof(faceRect));
+	std::vector<unsigned char>().swap(atlasPixels);
+}
+
+void BatchRenderer::begin()
+{
+	tanques.clear();
+	triangulos.clear();
+}
+
+void BatchRenderer::vertex(int face, float u, float v, const Vector &normal, const Vector &p)
+{
+	tanques.push_back(faceRect[face][0] + u*faceRect[face][2]);
+	tanques.push_back(faceRect[face][1] + v*faceRect[face][3]);
+	tanques.push_back(normal.getX());
+	tanques.push_back(normal.getY());
+	tanques.push_back(normal.getZ());
+	tanques.push_back(p.getX());
+	tanques.push_back(p.getY());
+	tanques.push_back(p.getZ());
+}
+
+// A caixa texturizada do tanque, ja transformada para o mundo.
+void BatchRenderer::addTank(const Vector &pos, const Vector &dir, const Vector &side, const Vector &up)
+{
+	double size = 1/8.0;
+	Vector dirl = dir*size*(1+sqrt(5))/2.0; // Razão de ouro!
+	Vector sidel = side*size;
+	Vector upl = up*size;
+
+	Vector P1 = pos + dirl - sidel;
+	Vector P2 = P1 + upl;
+	Vector P3 = P2 + sidel * 2;
+	Vector P4 = P3 - upl;
+
+	Vector P5 = P1 - dirl * 2;
+	Vector P6 = P2 - dirl * 2;
+	Vector P7 = P3 - dirl * 2;
+	Vector P8 = P4 - dirl * 2;
+
+	// Ajustes para caber na textura.
+	P5 = P5 + dirl*0.23;
+	P8 = P8 + dirl*0.23;
+
+	vertex(FACE_FRENTE, 0.0f, 0.0f, dir, P1);
+	vertex(FACE_FRENTE, 1.0f, 0.0f, dir, P4);
+	vertex(FACE_FRENTE, 1.0f, 1.0f, dir, P3);
+	vertex(FACE_FRENTE, 0.0f, 1.0f, dir, P2);
+
+	vertex(FACE_VERSO, 0.0f, 0.0f, dir*(-1.0), P5);
+	vertex(FACE_VERSO, 1.0f, 0.0f, dir*(-1.0), P8);
+	vertex(FACE_VERSO, 1.0f, 1.0f, dir*(-1.0), P7);
+	vertex(FACE_VERSO, 0.0f, 1.0f, dir*(-1.0), P6);
+
+	vertex(FACE_LATERAL_DIR, 0.15f, 0.0f, side*(-1.0), P5);
+	vertex(FACE_LATERAL_DIR, 1.0f-0.06f, 0.0f, side*(-1.0), P1);
+	vertex(FACE_LATERAL_DIR, 1.0f, 1.0f, side*(-1.0), P2);
+	vertex(FACE_LATERAL_DIR, 0.0f, 1.0f, side*(-1.0), P6);
+
+	vertex(FACE_LATERAL_ESQ, 0.06f, 0.0f, side, P4);
+	vertex(FACE_LATERAL_ESQ, 1.0f-0.15f, 0.0f, side, P8);
+	vertex(FACE_LATERAL_ESQ, 1.0f, 1.0f, side, P7);
+	vertex(FACE_LATERAL_ESQ, 0.0f, 1.0f, side, P3);
+
+	vertex(FACE_TOPO, 0.0f, 0.0f, up, P6);
+	vertex(FACE_TOPO, 1.0f, 0.0f, up, P2);
+	vertex(FACE_TOPO, 1.0f, 1.0f, up, P3);
+	vertex(FACE_TOPO, 0.0f, 1.0f, up, P7);
+}
+
+void BatchRenderer::addTankImpostor(const Vector &pos, const Vector &up, const Vector &olho)
+{
+	double size = 1/8.0;
+	Vector normal = olho - pos;
+	normal = (normal - up*normal.dotProduct(up)).setVectorLength(1.0);
+	Vector lado = up.crossProduct(normal)*(size*(1+sqrt(5))/2.0);
+	Vector upl = up*size;
+
+	vertex(FACE_LATERAL_DIR, 0.0f, 0.0f, normal, pos - lado);
+	vertex(FACE_LATERAL_DIR, 1.0f, 0.0f, normal, pos + lado);
+	vertex(FACE_LATERAL_DIR, 1.0f, 1.0f, normal, pos + lado + upl);
+	vertex(FACE_LATERAL_DIR, 0.0f, 1.0f, normal, pos - lado + upl);
+}
+
+void BatchRenderer::addTriangle(const Vector &a, const Vector &b, const Vector &c,
+                                float red, float green, float blue)
+{
+	const Vector *v[3] = { &a, &b, &c };
+	for(int i = 0; i < 3; i++)
+	{
+		triangulos.push_back(red);
+		triangulos.push_back(green);
+		triangulos.push_back(blue);
+		triangulos.push_back(v[i]->getX());
+		triangulos.push_back(v[i]->getY());
+		triangulos.push_back(v[i]->getZ());
+	}
+}
+
+// Piramide vermelha de um tiro.
+void BatchRenderer::addProjetil(const Vector &pos, const Vector &dir, const Vector &side, const Vector &up)
+{
+	double size = 1/5.0;
+
+	Vector ponta = pos + dir*2*size;
+	Vector A = pos + side*(-size/2) - up*(size/5);
+	Vector B = pos + side*(size/2) - up*(size/5);
+	Vector C = pos + side*(size/2) + up*(size/5);
+	Vector D = pos + side*(-size/2) + up*(size/5);
+
+	addTriangle(ponta, A, B, 1, 0, 0);
+	addTriangle(ponta, D, C, 1, 0, 0);
+	addTriangle(ponta, D, A, 1, 0, 0);
+	addTriangle(ponta, C, B, 1, 0, 0);
+}
+
+void BatchRenderer::addRadar(const Vector &pos, const Vector &dir, const Vector &up, const Vector &alvo)
+{
+	double size = 1.0/16;
+	Vector direcaoMaisProx = alvo - pos;
+	double seno = dir.crossProduct(direcaoMaisProx).getLengthVector();
+	double cosseno = dir.dotProduct(direcaoMaisProx);
+
+	double phi;
+	if(cosseno == 0) phi = M_PI/2;
+	else phi = atan2(seno,cosseno);
+
+	Vector centro = pos + Vector(0,0,0.2);
+
+	Vector local_dir = dir;
+	Vector local_side = up;
+	Vector local_up = up;
+
+	local_dir = local_dir.rotateVector(up,phi).setVectorLength(1.0);
+	local_side = local_side.crossProduct(dir);
+
+	Vector ponta = centro + local_dir*2*size;
+	Vector A = centro + local_side*(-size/2) - local_up*(size/5);
+	Vector B = centro + local_side*(size/2) - local_up*(size/5);
+	Vector C = centro + local_side*(size/2) + local_up*(size/5);
+	Vector D = centro + local_side*(-size/2) + local_up*(size/5);
+
+	addTriangle(ponta, A, B, 0.2, 0.7, 0.1);
+	addTriangle(ponta, D, C, 0.2, 0.7, 0.1);
+	addTriangle(D, C, B, 0.2, 0.7, 0.1);
+	addTriangle(B, A, D, 0.2, 0.7, 0.1);
+}
+
+void BatchRenderer::drawBatch(GLuint buffer, const std::vector<GLfloat> &dados, GLenum formato,
+                              GLenum primitiva, int floatsPorVertice)
+{
+	if(dados.empty()) return;
+
+	// Buffer novo a cada quadro: o driver nao precisa esperar o quadro anterior terminar.
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	glBufferData(GL_ARRAY_BUFFER, dados.size()*sizeof(GLfloat), &dados[0], GL_STREAM_DRAW);
+	glInterleavedArrays(formato, 0, (const GLvoid *) 0);
+	glDrawArrays(primitiva, 0, (GLsizei) (dados.size() / floatsPorVertice));
+
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void BatchRenderer::flush()
+{
+	if(!pronto) init();
+
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	drawBatch(buffers[0], tanques, GL_T2F_N3F_V3F, GL_QUADS, FLOATS_TANQUE);
+
+	// Tiros e radar: sem textura, e com a cor de cada vertice como material. O
+	// material e a cor corrente voltam ao que eram para nao tingir o chao.
+	glPushAttrib(GL_ENABLE_BIT | GL_LIGHTING_BIT | GL_CURRENT_BIT);
+	glDisable(GL_TEXTURE_2D);
+	glEnable(GL_COLOR_MATERIAL);
+	glNormal3f(0, 0, 1);
+	drawBatch(buffers[1], triangulos, GL_C3F_V3F, GL_TRIANGLES, FLOATS_TRIANGULO);
+	glPopAttrib();
+}
@@ -0,0 +1,89 @@
+/*
+ * BatchRenderer.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef BATCHRENDERER_H_
+#define BATCHRENDERER_H_
+
+#include <vector>
+#include <atomic>
+#include "GLDraw.h"
+#include "Vector.h"
+
+// Faces do tanque, na ordem em que ficam no atlas.
+#define FACE_FRENTE 0
+#define FACE_VERSO 1
+#define FACE_LATERAL_DIR 2
+#define FACE_LATERAL_ESQ 3
+#define FACE_TOPO 4
+#define TANK_FACES 5
+
+// Junta tudo o que os agentes desenham em um quadro em dois lotes: os tanques, com
+// as cinco texturas em um atlas so, e os triangulos sem textura (tiros e radar).
+// Cada lote vai para um VBO e sai em uma unica chamada de desenho. Os recursos de
+// GL so sao criados em load() ou no primeiro flush(), entao o modo headless nunca
+// toca no GL.
+class BatchRenderer {
+private:
+	typedef struct FaceJob {
+		BatchRenderer *r;
+		int face;
+		bool montou; // Foi esta face que completou o atlas.
+	} FaceJob;
+
+	bool pronto;
+	GLuint atlas;
+	GLuint buffers[2];
+	float faceRect[TANK_FACES][4]; // u0, v0, largura e altura de cada face no atlas.
+
+	// Montagem do atlas nas threads do carregador.
+	FaceJob faceJobs[TANK_FACES];
+	Image faces[TANK_FACES];
+	std::atomic<int> facesLidas;
+	std::vector<unsigned char> atlasPixels;
+	unsigned long atlasLargura, atlasAltura;
+	float atlasRect[TANK_FACES][4];
+
+	std::vector<GLfloat> tanques;    // Quads em GL_T2F_N3F_V3F.
+	std::vector<GLfloat> triangulos; // Triangulos em GL_C3F_V3F.
+
+	void init();
+	void createBuffers();
+	void composeAtlas();
+	void uploadAtlas();
+	static bool decodeFace(void *ctx);
+	static void uploadFace(void *ctx);
+	void vertex(int face, float u, float v, const Vector &normal, const Vector &p);
+	void drawBatch(GLuint buffer, const std::vector<GLfloat> &dados, GLenum formato,
+	               GLenum primitiva, int floatsPorVertice);
+
+	BatchRenderer(const BatchRenderer &);
+	BatchRenderer &operator=(const BatchRenderer &);
+
+public:
+	BatchRenderer();
+
+	// Cria os recursos de GL ja, com um substituto no lugar do atlas, e deixa as
+	// faces do tanque para o carregador.
+	void load(AssetLoader *assets);
+
+	// Esvazia os lotes; chamado no inicio de cada quadro.
+	void begin();
+
+	void addTank(const Vector &pos, const Vector &dir, const Vector &side, const Vector &up);
+	// Tanque distante: um quad com a lateral do tanque, em pe e virado para 'olho'.
+	void addTankImpostor(const Vector &pos, const Vector &up, const Vector &olho);
+	void addTriangle(const Vector &a, const Vector &b, const Vector &c,
+	                 float red, float green, float blue);
+	void addProjetil(const Vector &pos, const Vector &dir, const Vector &side, const Vector &up);
+	// Seta do radar sobre o jogador em 'pos', apontando para 'alvo'.
+	void addRadar(const Vector &pos, const Vector &dir, const Vector &up, const Vector &alvo);
+
+	// Envia os lotes para o GL e desenha. Deve ser chamado com a camera ja posicionada.
+	void flush();
+};
+
+#endif /* BATCHRENDERER_H_ */
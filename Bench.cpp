@@ -0,0 +1,319 @@
+/*
+ * Bench.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "GameData.h"
+#include "SpatialGrid.h"
+#include "ProjectileSystem.h"
+#include "Timer.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// Microbenchmarks dos lacos quentes, para conferir com numeros cada mudanca de
+// desempenho: ns por operacao e alocacoes por operacao. Tudo em uma thread, com
+// a mesma semente, entao duas corridas na mesma maquina sao comparaveis.
+//
+// Uso: ./jogoThaylo-bench [--quick] [FILTRO]  (so os casos cujo nome contem FILTRO)
+
+// Todo new do processo passa por aqui (os Pools tambem, quando crescem).
+static std::atomic<long> alocacoes(0);
+
+void *operator new(size_t size)
+{
+	alocacoes++;
+	void *p = malloc(size ? size : 1);
+	if(p == NULL) throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	free(p);
+}
+
+// Impede o compilador de jogar fora o resultado medido.
+static volatile double sumidouro;
+
+#define BENCH_VETORES 1024
+
+typedef struct Caso {
+	const char *nome;
+	void *ctx;
+	void (*setup)(void *ctx, int n);
+	// Roda 'reps' vezes; devolve quantas operacoes fez.
+	long (*run)(void *ctx, int reps);
+	void (*teardown)(void *ctx);
+	int n;
+	int reps;
+} Caso;
+
+// Vector ----------------------------------------------------------------------
+
+typedef struct VetoresCtx {
+	Vector v[BENCH_VETORES];
+	Vector w[BENCH_VETORES];
+} VetoresCtx;
+
+static VetoresCtx vetores;
+
+static void setupVetores(void *ctx, int /*n*/)
+{
+	VetoresCtx *c = (VetoresCtx *) ctx;
+	unsigned int s = 1;
+	for(int i = 0; i < BENCH_VETORES; i++)
+	{
+		c->v[i] = Vector(rand_r(&s) % 100 - 50, rand_r(&s) % 100 - 50, rand_r(&s) % 10);
+		c->w[i] = Vector(rand_r(&s) % 100 - 50, rand_r(&s) % 100 - 50, 1).normalized();
+	}
+}
+
+static long runLength(void *ctx, int reps)
+{
+	VetoresCtx *c = (VetoresCtx *) ctx;
+	double soma = 0;
+	for(int r = 0; r < reps; r++)
+	{
+		for(int i = 0; i < BENCH_VETORES; i++)
+		{
+			soma += c->v[i].getLengthVector();
+		}
+	}
+	sumidouro = soma;
+	return (long) reps * BENCH_VETORES;
+}
+
+static long runRotate(void *ctx, int reps)
+{
+	VetoresCtx *c = (VetoresCtx *) ctx;
+	double soma = 0;
+	for(int r = 0; r < reps; r++)
+	{
+		for(int i = 0; i < BENCH_VETORES; i++)
+		{
+			soma += c->v[i].rotateVector(c->w[i], 0.01 * (i & 63)).getX();
+		}
+	}
+	sumidouro = soma;
+	return (long) reps * BENCH_VETORES;
+}
+
+static long runCross(void *ctx, int reps)
+{
+	VetoresCtx *c = (VetoresCtx *) ctx;
+	double soma = 0;
+	for(int r = 0; r < reps; r++)
+	{
+		for(int i = 0; i < BENCH_VETORES; i++)
+		{
+			soma += c->v[i].crossProduct(c->w[i]).getZ();
+		}
+	}
+	sumidouro = soma;
+	return (long) reps * BENCH_VETORES;
+}
+
+// Integracao (o antigo Movable::iterate) e busca do mais proximo ------------------
+
+typedef struct CorposCtx {
+	EntityStore *store;
+	std::vector<Agent *> agentes;
+	SpatialGrid *grid;
+} CorposCtx;
+
+static CorposCtx corpos;
+
+// Os mesmos tanques do GameData: +-25 em volta da origem, andando e girando.
+static void setupCorpos(void *ctx, int n)
+{
+	CorposCtx *c = (CorposCtx *) ctx;
+	c->store = new EntityStore();
+	c->store->reserve(n);
+	c->grid = new SpatialGrid();
+	unsigned int s = 1;
+	for(int i = 0; i < n; i++)
+	{
+		Agent *a = new Agent(c->store, Vector((rand_r(&s)%100)/4.0 - 25.0, (rand_r(&s)%100)/4.0 - 25.0, 0));
+		a->setId(i % 10 ? 0 : PLAYER_ID);
+		a->setAcelerration(a->getDir() * MOVABLE_MAX_ACCELERATION);
+		a->setVYaw((i % 3) - 1);
+		c->agentes.push_back(a);
+		c->grid->insert(a);
+	}
+	c->grid->build();
+}
+
+static void teardownCorpos(void *ctx)
+{
+	CorposCtx *c = (CorposCtx *) ctx;
+	for(int i = (int) c->agentes.size() - 1; i >= 0; i--)
+	{
+		delete c->agentes[i];
+	}
+	c->agentes.clear();
+	delete c->grid;
+	delete c->store;
+}
+
+static long runIntegrate(void *ctx, int reps)
+{
+	CorposCtx *c = (CorposCtx *) ctx;
+	for(int r = 0; r < reps; r++)
+	{
+		c->store->integrate();
+	}
+	return (long) reps * c->store->size();
+}
+
+static long runNearest(void *ctx, int reps)
+{
+	CorposCtx *c = (CorposCtx *) ctx;
+	long achados = 0;
+	for(int r = 0; r < reps; r++)
+	{
+		for(unsigned int i = 0; i < c->agentes.size(); i++)
+		{
+			Agent *a = c->agentes[i];
+			if(c->grid->nearest(a->getPosition(), RADAR_MAX_DIST, a, PLAYER_ID) != NULL) achados++; // Como o radar.
+		}
+	}
+	sumidouro = achados;
+	return (long) reps * c->agentes.size();
+}
+
+// Tiros -------------------------------------------------------------------------
+
+typedef struct TirosCtx {
+	ProjectileSystem *tiros;
+} TirosCtx;
+
+static TirosCtx tiros;
+
+// Dois times atirando em direcoes ao acaso; o laco de colisao tiro contra tiro e
+// o teste continuo de cada par vizinho.
+static void setupTiros(void *ctx, int n)
+{
+	TirosCtx *c = (TirosCtx *) ctx;
+	c->tiros = new ProjectileSystem();
+	c->tiros->reserve(n);
+	unsigned int s = 1;
+	for(int i = 0; i < n; i++)
+	{
+		Vector p((rand_r(&s)%1000)/10.0 - 50.0, (rand_r(&s)%1000)/10.0 - 50.0, 0);
+		Vector d(rand_r(&s)%200 - 100, rand_r(&s)%200 - 100, 0);
+		c->tiros->spawn(p, d.getLengthSquared() > 0 ? d : Vector(1, 0, 0), i % 2 ? PLAYER_ID : 0);
+	}
+	c->tiros->integrate(0, n);
+}
+
+static void teardownTiros(void *ctx)
+{
+	delete ((TirosCtx *) ctx)->tiros;
+}
+
+static long runColisaoTiros(void *ctx, int reps)
+{
+	TirosCtx *c = (TirosCtx *) ctx;
+	for(int r = 0; r < reps; r++)
+	{
+		c->tiros->collideOpposing();
+	}
+	return (long) reps * c->tiros->size();
+}
+
+// Iteracao inteira ---------------------------------------------------------------
+
+typedef struct MundoCtx {
+	GameData *mundo;
+} MundoCtx;
+
+static MundoCtx mundo;
+
+// Uma thread so, para o numero nao depender da maquina; aquecido por 50 iteracoes
+// para os tiros e os pools ja estarem no regime da partida.
+static void setupMundo(void *ctx, int n)
+{
+	MundoCtx *c = (MundoCtx *) ctx;
+	c->mundo = new GameData(n, 1, 1);
+	c->mundo->setSilencioso(true);
+	for(int i = 0; i < 50; i++)
+	{
+		c->mundo->iterateGameData();
+	}
+}
+
+static void teardownMundo(void *ctx)
+{
+	delete ((MundoCtx *) ctx)->mundo;
+}
+
+static long runTick(void *ctx, int reps)
+{
+	MundoCtx *c = (MundoCtx *) ctx;
+	for(int r = 0; r < reps; r++)
+	{
+		c->mundo->iterateGameData();
+	}
+	return reps;
+}
+
+static const Caso casos[] = {
+	{ "vector/getLengthVector", &vetores, setupVetores, runLength, NULL, 0, 20000 },
+	{ "vector/rotateVector", &vetores, setupVetores, runRotate, NULL, 0, 5000 },
+	{ "vector/crossProduct", &vetores, setupVetores, runCross, NULL, 0, 20000 },
+	{ "integrate/10", &corpos, setupCorpos, runIntegrate, teardownCorpos, 10, 200000 },
+	{ "integrate/1k", &corpos, setupCorpos, runIntegrate, teardownCorpos, 1000, 2000 },
+	{ "integrate/10k", &corpos, setupCorpos, runIntegrate, teardownCorpos, 10000, 200 },
+	{ "nearest/10", &corpos, setupCorpos, runNearest, teardownCorpos, 10, 100000 },
+	{ "nearest/1k", &corpos, setupCorpos, runNearest, teardownCorpos, 1000, 200 },
+	{ "nearest/10k", &corpos, setupCorpos, runNearest, teardownCorpos, 10000, 10 },
+	{ "tiros/colisao/10", &tiros, setupTiros, runColisaoTiros, teardownTiros, 10, 100000 },
+	{ "tiros/colisao/1k", &tiros, setupTiros, runColisaoTiros, teardownTiros, 1000, 2000 },
+	{ "tiros/colisao/10k", &tiros, setupTiros, runColisaoTiros, teardownTiros, 10000, 100 },
+	{ "tick/10", &mundo, setupMundo, runTick, teardownMundo, 10, 5000 },
+	{ "tick/1k", &mundo, setupMundo, runTick, teardownMundo, 1000, 300 },
+	{ "tick/10k", &mundo, setupMundo, runTick, teardownMundo, 10000, 60 },
+};
+
+int main(int argc, char **argv)
+{
+	const char *filtro = NULL;
+	int divisor = 1;
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i], "--quick") == 0) divisor = 10;
+		else filtro = argv[i];
+	}
+
+	printf("%-24s %12s %14s %10s\n", "caso", "ns/op", "alocacoes/op", "ops");
+	for(unsigned int i = 0; i < sizeof(casos)/sizeof(casos[0]); i++)
+	{
+		const Caso &caso = casos[i];
+		if(filtro != NULL && strstr(caso.nome, filtro) == NULL) continue;
+
+		void *ctx = caso.ctx;
+		caso.setup(ctx, caso.n);
+		int reps = caso.reps / divisor > 0 ? caso.reps / divisor : 1;
+		caso.run(ctx, reps / 10 > 0 ? reps / 10 : 1); // Aquecimento.
+
+		long antes = alocacoes;
+		long long t0 = getMonotonicTime();
+		long ops = caso.run(ctx, reps);
+		long long t = getMonotonicTime() - t0;
+		long feitas = alocacoes - antes;
+
+		printf("%-24s %12.1f %14.3f %10ld\n", caso.nome, (double) t / ops, (double) feitas / ops, ops);
+		if(caso.teardown) caso.teardown(ctx);
+	}
+	return 0;
+}
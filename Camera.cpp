@@ -4,7 +4,7 @@
 Camera::Camera()
 {
 	tracked = NULL;
-	position = Vector(0,0,1);
+	position = prevPosition = Vector(0,0,1);
 	velocity = Vector(0,0,-1);
 	dir = Vector(1,0,0);
 	up = Vector(0,1,0);
@@ -15,7 +15,7 @@ Camera::Camera()
 Camera::Camera(Movable *track)
 {
 	tracked = track;
-	position = Vector(0,0,1);
+	position = prevPosition = Vector(0,0,1);
 	velocity = Vector(0,0,-1);
 	dir = Vector(1,0,0);
 	up = Vector(0,1,0);
@@ -32,11 +32,11 @@ void Camera::draw()
 
 }
 
-void Camera::posiciona()
+void Camera::posiciona(const Vector &olho, const Vector &alvo, const Vector &up)
 {
    gluLookAt(
-	position.getX(),position.getY(),position.getZ(),
-	tracked->getPosition().getX(),tracked->getPosition().getY(),tracked->getPosition().getZ(),
+	olho.getX(),olho.getY(),olho.getZ(),
+	alvo.getX(),alvo.getY(),alvo.getZ(),
 	up.getX(),up.getY(),up.getZ());
 
 }
@@ -50,6 +50,7 @@ void Camera::iterate()
 {
 
 	double factor = 0.6;
+	prevPosition = position;
 	position = tracked->getPosition() - tracked->getDir().setVectorLength(factor) - tracked->getVelocity().setVectorLength(factor) + Vector(0,0,factor);
 
 	dir = tracked->getDir().setVectorLength(1.0) + tracked->getVelocity().setVectorLength(factor);
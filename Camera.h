@@ -7,18 +7,30 @@
 
 extern GLfloat light_position[];
 
-class Camera: public Movable, public oDrawable{
+class Camera: public oDrawable{
 public:
 	Camera();
 	Camera(Movable *track);
 	void iterate();
 	void draw();
-	void posiciona();
+	Vector getPosition() const { return position; }
+	Vector getPrevPosition() const { return prevPosition; }
+	Vector getUp() const { return up; }
+
+	// Aplica o gluLookAt; o desenho passa olho e alvo ja interpolados.
+	static void posiciona(const Vector &olho, const Vector &alvo, const Vector &up);
 	//Movable *getTracked();
 	~Camera();
 private:
 	Movable *tracked;
 
+	Vector position;
+	Vector prevPosition;
+	Vector velocity;
+	Vector up;
+	Vector dir;
+	Vector side;
+
 
 
 };
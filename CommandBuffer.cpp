@@ -0,0 +1,47 @@
+/*
+ * CommandBuffer.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "CommandBuffer.h"
+#include <algorithm>
+
+void CommandBuffer::spawn(const Vector &posicao, const Vector &dir, int dono, int ordem)
+{
+	ComandoDisparo c;
+	c.posicao = posicao;
+	c.dir = dir;
+	c.dono = dono;
+	c.ordem = ordem;
+	disparos.push_back(c);
+}
+
+void CommandBuffer::destroy(Agent *alvo)
+{
+	destruicoes.push_back(alvo);
+}
+
+void CommandBuffer::take(CommandBuffer &outro)
+{
+	disparos.insert(disparos.end(), outro.disparos.begin(), outro.disparos.end());
+	destruicoes.insert(destruicoes.end(), outro.destruicoes.begin(), outro.destruicoes.end());
+	outro.clear();
+}
+
+static bool antes(const ComandoDisparo &a, const ComandoDisparo &b)
+{
+	return a.ordem < b.ordem;
+}
+
+void CommandBuffer::sortSpawns()
+{
+	std::sort(disparos.begin(), disparos.end(), antes);
+}
+
+void CommandBuffer::clear()
+{
+	disparos.clear();
+	destruicoes.clear();
+}
@@ -0,0 +1,50 @@
+/*
+ * CommandBuffer.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef COMMANDBUFFER_H_
+#define COMMANDBUFFER_H_
+
+#include <vector>
+#include "Vector.h"
+
+namespace std {
+class Agent;
+}
+
+// Um disparo pedido durante a iteracao, com o estado do atirador no momento.
+typedef struct ComandoDisparo {
+	Vector posicao;
+	Vector dir;
+	int dono;   // Agent::getId() de quem atirou.
+	int ordem;  // Slot do atirador ao pedir: ordena a aplicacao entre threads.
+} ComandoDisparo;
+
+// Criacoes e destruicoes pedidas durante uma iteracao. Ninguem altera o mundo no
+// meio das fases: cada thread escreve no proprio buffer e o GameData aplica tudo
+// de uma vez no fim da iteracao.
+class CommandBuffer {
+private:
+	std::vector<ComandoDisparo> disparos;
+	std::vector<Agent *> destruicoes;
+
+public:
+	void spawn(const Vector &posicao, const Vector &dir, int dono, int ordem);
+	// O mesmo agente pode aparecer mais de uma vez (varios tiros no mesmo passo).
+	void destroy(Agent *alvo);
+	// Junta os comandos de 'outro' aos deste e esvazia 'outro'.
+	void take(CommandBuffer &outro);
+	// Disparos na ordem dos slots dos atiradores, independente de qual thread os pediu.
+	void sortSpawns();
+	void clear();
+
+	int getQuantDisparos() const { return (int) disparos.size(); }
+	const ComandoDisparo &getDisparo(int i) const { return disparos[i]; }
+	int getQuantDestruicoes() const { return (int) destruicoes.size(); }
+	Agent *getDestruicao(int i) const { return destruicoes[i]; }
+};
+
+#endif /* COMMANDBUFFER_H_ */
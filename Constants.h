@@ -4,7 +4,15 @@
 // Milliseconds
 
 //#define TIME_STEP 15
+// Pode ser trocado na compilacao (make CXXFLAGS="-O2 -pthread -DTIME_STEP=50"): as
+// colisoes dos tiros sao continuas e nao dependem de um passo pequeno.
+#ifndef TIME_STEP
 #define TIME_STEP 20 // para desenhar porcarias rápido
+#endif
+
+#define MAX_STEPS_PER_FRAME 5 // Passos de logica que um quadro lento pode recuperar.
+#define FRAME_STEP 8 // Intervalo minimo entre quadros (~120 fps).
+#define FRAME_ALVO 60 // Quadros por segundo que o FrameGovernor tenta manter (--fps).
 
 #define TRUE 1
 
@@ -37,4 +45,28 @@
 
 #define PLAYER_ID 642
 
+#define JOGO_ANDAMENTO 0
+#define JOGO_DERROTA 1
+#define JOGO_VITORIA 2
+
+#define SPATIAL_GRID_CELL 4.0 // Lado da celula da grade espacial (unidades do mundo).
+#define RADAR_MAX_DIST 1000.0
+
+#define PROJETIL_HIT_RADIUS 0.5
+// O maximo que um tanque anda em um passo, para a busca das colisoes continuas.
+#define TANK_MAX_STEP (MOVABLE_MAX_VELOCITY*TIME_STEP/1000.0)
+#define PROJETIL_RANGE 40.0
+#define COLLISION_GRID_CELL (2*PROJETIL_HIT_RADIUS)
+
+// Agenda da IA dos inimigos. Perto do alvo o inimigo decide em toda iteracao; mais
+// longe so a cada AI_INTERVALO_MEDIO ou AI_INTERVALO_LONGE iteracoes, espalhados
+// entre as iteracoes, e no maximo AI_ORCAMENTO dessas decisoes por iteracao.
+#define AI_DIST_PERTO 16.0 // Acima do alcance de tiro (13) com folga.
+#define AI_DIST_LONGE 40.0
+#define AI_INTERVALO_MEDIO 4
+#define AI_INTERVALO_LONGE 16
+#define AI_ORCAMENTO 256
+// Erro de rumo aceito pelo inimigo, em radianos (o 0.02 do Enemy original).
+#define AI_TOLERANCIA_GIRO 0.02
+
 #endif
@@ -21,6 +21,10 @@ Control initializeControl()
 	control.scrollPressed  = 0;
 	
 	control.space = 0;
+	for(int i = 0; i < JOYPAD_BUTTONS; i++)
+	{
+		control.joypad[i] = 0;
+	}
 	control.pressedPos = Vector(0,0,0);
 	control.releasedPos = Vector(0,0,0);
 
@@ -2,6 +2,7 @@
 #define CONTROL_H_
 
 #include "Vector.h"
+#include "joystick.h"
 
 typedef struct Control {
 	bool arrowUp;
@@ -20,6 +21,8 @@ typedef struct Control {
 	bool space;
 
 	bool keyEsc;
+
+	int joypad[JOYPAD_BUTTONS]; // 1 = apertado (ver joystick.h).
 	
 	Vector pressedPos;
 	Vector releasedPos;
@@ -7,9 +7,8 @@
 
 #include "Controlable.h"
 
-Controlable::Controlable()
+Controlable::Controlable(EntityStore *store, const Vector &pos, int type) : Movable(store, pos, type)
 {
-	Movable();
 	control = NULL;
 }
 
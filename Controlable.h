@@ -17,7 +17,7 @@ class Controlable : public Movable {
 protected:
 	Control *control;
 public:
-	Controlable();
+	Controlable(EntityStore *store, const Vector &pos, int type);
 	void setController(Control *control_);
 	virtual void controlAction() = 0;
 	virtual ~Controlable();
@@ -0,0 +1,58 @@
+/*
+ * Debug.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "Debug.h"
+#include "Timer.h"
+#include <stdarg.h>
+#include <mutex>
+
+static FILE *sink = NULL;
+static int limite = 0;
+static long long inicioJanela = 0;
+static int escritas = 0;
+static long descartadas = 0;
+static std::mutex debugMutex;
+
+void setDebugSink(FILE *saida, int linhasPorSegundo)
+{
+	std::lock_guard<std::mutex> lock(debugMutex);
+	sink = saida;
+	limite = linhasPorSegundo;
+	inicioJanela = getMonotonicTime();
+	escritas = 0;
+	descartadas = 0;
+}
+
+void debugPrintf(const char *fmt, ...)
+{
+	if(sink == NULL) return;
+
+	std::lock_guard<std::mutex> lock(debugMutex);
+	long long agora = getMonotonicTime();
+	if(agora - inicioJanela >= 1000000000LL)
+	{
+		if(descartadas > 0)
+		{
+			fprintf(sink, "(debug: %ld mensagens descartadas)\n", descartadas);
+		}
+		inicioJanela = agora;
+		escritas = 0;
+		descartadas = 0;
+	}
+
+	if(escritas >= limite)
+	{
+		descartadas++;
+		return;
+	}
+	escritas++;
+
+	va_list args;
+	va_start(args, fmt);
+	vfprintf(sink, fmt, args);
+	va_end(args);
+}
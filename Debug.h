@@ -0,0 +1,20 @@
+/*
+ * Debug.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef DEBUG_H_
+#define DEBUG_H_
+
+#include <stdio.h>
+
+// Saida de depuracao opcional. Desligada por padrao; quando ligada, escreve no
+// maximo 'linhasPorSegundo' linhas por segundo e so conta o que passar disso,
+// para um terminal lento nao travar o quadro. setDebugSink() deve ser chamada
+// antes de as threads comecarem.
+void setDebugSink(FILE *saida, int linhasPorSegundo);
+void debugPrintf(const char *fmt, ...);
+
+#endif /* DEBUG_H_ */
@@ -6,66 +6,194 @@
  */
 
 #include "Enemy.h"
+#include "GameData.h"
 
 namespace std {
 
-Enemy::Enemy() {
+static const double COS_TOLERANCIA_GIRO = cos(AI_TOLERANCIA_GIRO);
+
+Enemy::Enemy(EntityStore *store, Agent *alvo) : Agent(store, Vector(0,0,0), ENTITY_INIMIGO) {
 	control = NULL;
-	target = NULL;
+	target = alvo ? alvo->getHandle() : nullHandle();
+	cacador = alvo == NULL;
+	if(cacador) setRadar(true);
+	fase = getSlot();
+	pensar = true;
+	atrasado = false;
+	giroRestante = 0;
+	campo = NULL;
 }
 
-Enemy::Enemy(Agent *alvo) {
-	control = NULL;
-	target = alvo;
+Agent *Enemy::getAlvo() const
+{
+	if(cacador) return getMaisProximo();
+	Agent *alvo = resolveAgent(getStore(), target);
+	return alvo != NULL && !alvo->isToDestroy() ? alvo : NULL; // O jogador destruido fica no store.
+}
+
+void Enemy::saveEstado(AgentEstado &e) const
+{
+	Agent::saveEstado(e);
+	Agent *alvo = resolveAgent(getStore(), target);
+	e.alvo = alvo ? alvo->getSlot() : -1;
+	e.fase = fase;
+	e.giroRestante = giroRestante;
+	e.cacador = cacador;
+	e.pensar = pensar;
+	e.atrasado = atrasado;
+}
+
+void Enemy::restoreEstado(const AgentEstado &e)
+{
+	Agent::restoreEstado(e);
+	target = e.alvo >= 0 ? getStore()->getBody(e.alvo)->getHandle() : nullHandle();
+	fase = e.fase;
+	giroRestante = e.giroRestante;
+	cacador = e.cacador;
+	pensar = e.pensar;
+	atrasado = e.atrasado;
+}
+
+void Enemy::rumoAlvo(const Agent *alvo, Vector &direcao, double &distancia) const
+{
+	if(campo != NULL && campo->sample(getPosition(), direcao, distancia)) return;
+
+	Vector A = alvo->getPosition() - getPosition();
+	distancia = A.getLengthVector();
+	direcao = distancia > 0 ? A * (1/distancia) : A;
+}
+
+Agent *Enemy::schedule(const GameData *mundo, int &orcamento)
+{
+	long tick = mundo->getIteracao();
+	campo = NULL;
+	pensar = true;
+	Agent *alvo = getAlvo();
+	// No servidor o mundo segue depois que o jogador local morre: vai atras do
+	// tanque de cliente mais proximo, na sua vez das decisoes longes. Sem nenhum
+	// vivo nem procura: a busca varreria a grade toda sem achar ninguem.
+	if(alvo == NULL && !cacador && target.index >= 0 && mundo->getJogadoresVivos() > 0 &&
+	   (tick + fase) % AI_INTERVALO_LONGE == 0)
+	{
+		alvo = findMaisProximo(mundo);
+		if(alvo != NULL) target = alvo->getHandle();
+	}
+	if(alvo == NULL) return NULL; // controlAction avisa ou para.
+
+	// So a distancia ao quadrado: aqui a conta exata sai mais barata que o campo.
+	double d2 = (alvo->getPosition() - getPosition()).getLengthSquared();
+	if(d2 < AI_DIST_PERTO*AI_DIST_PERTO)
+	{
+		atrasado = false;
+		return alvo;
+	}
+
+	// Longe: mantem a ultima decisao ate a sua vez, mas para de girar quando ja
+	// estaria de frente para o alvo, em vez de passar do ponto.
+	pensar = false;
+	if(giroRestante > 0 && --giroRestante == 0) setVYaw(0);
+	int intervalo = d2 < AI_DIST_LONGE*AI_DIST_LONGE ? AI_INTERVALO_MEDIO : AI_INTERVALO_LONGE;
+	if((tick + fase) % intervalo == 0) atrasado = true;
+	if(atrasado && orcamento > 0)
+	{
+		pensar = true;
+		atrasado = false;
+		orcamento--;
+	}
+	return alvo;
 }
 
 void Enemy::controlAction()
 {
-	if(target == NULL)
+	if(!pensar) return;
+
+	Agent *alvo = getAlvo();
+	if(alvo == NULL)
 	{
-		cout << "Alvo nao inicializado para o inimigo\n";
+		if(!cacador && target.index < 0) cout << "Alvo nao inicializado para o inimigo\n";
+		else if(!cacador)
+		{
+			// O alvo fixo foi destruido e nao ha outro tanque do jogador: para onde esta.
+			setVYaw(0);
+			giroRestante = 0;
+			setAcelerration(Vector(0,0,0));
+		}
 		return;
 	}
-	Vector A = target->getPosition() - position;
-	double seno = A.crossProduct(dir).getLengthVector();
+	Vector dir = getDir();
+	Vector A;
+	double distancia;
+	rumoAlvo(alvo, A, distancia);
+	// As duas direcoes sao unitarias: de frente para o alvo o cosseno basta, sem
+	// seno nem atan2.
 	double cosseno = A.dotProduct(dir);
-	double theta = atan2(seno,cosseno);
+	double theta = cosseno >= COS_TOLERANCIA_GIRO ? 0 : atan2(A.crossProduct(dir).getLengthVector(), cosseno);
 
 
-	if(theta > 0.02 && theta < M_PI)
+	if(theta > AI_TOLERANCIA_GIRO && theta < M_PI)
 	{
-		v_yaw = 1;
+		setVYaw(1);
+		// v_yaw = 1 rad/s: cada iteracao gira TIME_STEP/1000 rad.
+		giroRestante = (int) (theta / (TIME_STEP/1000.0) + 0.5);
 	}
-	else if(theta < -0.02 && theta >= M_PI)
+	else if(theta < -AI_TOLERANCIA_GIRO && theta >= M_PI)
 	{
-		v_yaw = -1;
+		setVYaw(-1);
 	}
 	else
 	{
-		v_yaw = 0;
+		setVYaw(0);
+		giroRestante = 0;
 	}
 
 	Vector nDir = dir;
-	if(A.getLengthVector() > 7)
+	if(distancia > 7)
 	{
-		aceleration = nDir.setVectorLength(MOVABLE_MAX_ACCELERATION);
+		setAcelerration(nDir.setVectorLength(MOVABLE_MAX_ACCELERATION));
 	}
 	else
 	{
-		aceleration = 0;
-		if(A.getLengthVector() < 13 && fabs(theta) < M_PI/15) atirar();
+		setAcelerration(Vector(0,0,0));
+		if(distancia < 13 && fabs(theta) < M_PI/15) Enemy::atirar();
 	}
 }
 
+void Enemy::think(const GameData *mundo)
+{
+	beginThink(mundo);
+	Enemy::controlAction();
+}
+
+void Enemy::iterate(const GameData *mundo)
+{
+	think(mundo);
+}
+
 Enemy::~Enemy() {
 }
 
 void Enemy::atirar()
 {
-	if (recarga > ROUNDS_RECARGA * ROUNDS_RECARGA_HANDICAP_FOR_IA)
+	if (getRecarga() > ROUNDS_RECARGA * ROUNDS_RECARGA_HANDICAP_FOR_IA)
 	{
 		Agent::atirar();
 	}
 }
 
+Pool &Enemy::pool()
+{
+	static Pool p(sizeof(Enemy));
+	return p;
+}
+
+void *Enemy::operator new(size_t size)
+{
+	return pool().allocate(size);
+}
+
+void Enemy::operator delete(void *p)
+{
+	pool().release(p);
+}
+
 } /* namespace std */
@@ -9,19 +9,57 @@
 #define ENEMY_H_
 
 #include "Agent.h"
+#include "PursuitField.h"
 
 namespace std {
 
 class Enemy: public std::Agent {
 private:
-	Agent *target;
+	// Ordenados para caber, com o Agent, numa linha de cache (ver o static_assert).
+	EntityHandle target;
+	int fase;      // Espalha as decisoes dos inimigos distantes entre as iteracoes.
+	int giroRestante; // Iteracoes de giro ate ficar de frente para o alvo.
+	bool cacador;  // Sem alvo fixo: persegue o mais proximo do radar.
+	bool pensar;   // Decide nesta iteracao.
+	bool atrasado; // Estava na vez mas o orcamento acabou.
+	const PursuitField *campo; // Do alvo, nesta iteracao; NULL para o cacador.
+
+	// Direcao unitaria e distancia ate o alvo: do campo quando longe, exatas perto.
+	void rumoAlvo(const Agent *alvo, Vector &direcao, double &distancia) const;
 public:
-	Enemy();
-	Enemy(Agent *alvo);
+	// Com alvo NULL o inimigo vira um cacador (o jogador controlado pela IA nas
+	// partidas em lote): liga o radar e vai atras do tanque mais proximo.
+	Enemy(EntityStore *store, Agent *alvo);
+	Agent *getAlvo() const;
+	// Agenda (serial, antes da fase paralela): marca se este inimigo decide nesta
+	// iteracao de 'mundo', gastando de 'orcamento' se estiver longe do alvo. Se o
+	// alvo fixo foi destruido, troca pelo tanque do jogador mais proximo. Devolve o
+	// alvo usado (NULL se nao ha).
+	Agent *schedule(const GameData *mundo, int &orcamento);
+	// O campo do alvo fixo para a decisao desta iteracao (NULL: conta exata).
+	void setCampo(const PursuitField *c) { campo = c; }
+	bool isCacador() const { return cacador; }
+	bool isAtrasado() const { return atrasado; }
+	bool isPensando() const { return pensar; }
 	void controlAction();
+	// Como os de Agent, mais o alvo e a agenda.
+	void saveEstado(AgentEstado &e) const;
+	void restoreEstado(const AgentEstado &e);
+	void think(const GameData *mundo);
+	virtual void iterate(const GameData *mundo);
 	virtual ~Enemy();
 	virtual void atirar();
+
+	static Pool &pool();
+	static void *operator new(size_t size);
+	static void operator delete(void *p);
 };
 
+// O que um corpo custa ao todo: as colunas do EntityStore e o objeto do Pool. O
+// objeto cabe numa linha de cache; o corpo inteiro, em tres.
+#define ENTITY_BYTES_CORPO(T) (ENTITY_BYTES_INTEGRACAO + ENTITY_BYTES_DECISAO + ENTITY_BYTES_RESTO + sizeof(T))
+static_assert(sizeof(Agent) <= 64 && sizeof(Enemy) <= 64, "Agent e Enemy devem caber numa linha de cache");
+static_assert(ENTITY_BYTES_CORPO(Enemy) <= 3*64, "um corpo deve caber em tres linhas de cache");
+
 } /* namespace std */
 #endif /* ENEMY_H_ */
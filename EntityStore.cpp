@@ -0,0 +1,284 @@
+/*
+ * EntityStore.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "EntityStore.h"
+#include "Movable.h"
+#include <algorithm>
+
+EntityHandle nullHandle()
+{
+	EntityHandle h;
+	h.index = -1;
+	h.generation = 0;
+	return h;
+}
+
+// Rumo 0 olha para -X, com o lado para +Y; girar o rumo gira os dois em torno de +Z.
+static inline Vec2f dirFromYaw(float y)
+{
+	Vec2f d = { -cosf(y), -sinf(y) };
+	return d;
+}
+
+static inline Vector sideFromDir(const Vec2f &d)
+{
+	return Vector(d.y, -d.x, 0);
+}
+
+static EntityCold initialCold()
+{
+	EntityCold c;
+	c.roll = c.pitch = 0;
+	c.v_roll = c.v_pitch = 0;
+	c.mass = c.charge = 1;
+	return c;
+}
+
+EntityStore::EntityStore()
+{
+	quantRolando = 0;
+}
+
+void EntityStore::reserve(int n)
+{
+	position.reserve(n);
+	velocity.reserve(n);
+	aceleration.reserve(n);
+	dir.reserve(n);
+	prevPosition.reserve(n);
+	prevDir.reserve(n);
+	yaw.reserve(n);
+	v_yaw.reserve(n);
+	type.reserve(n);
+	team.reserve(n);
+	recarga.reserve(n);
+	disparando.reserve(n);
+	maisProximo.reserve(n);
+	iteracaoMaisProximo.reserve(n);
+	cold.reserve(n);
+	body.reserve(n);
+	indexOf.reserve(n);
+	slotOf.reserve(n);
+	generation.reserve(n);
+	freeIndices.reserve(n);
+}
+
+int EntityStore::add(Movable *m, const Vector &pos, int type_)
+{
+	Vec2f p = toVec2f(pos), zero = { 0, 0 };
+	position.push_back(p);
+	velocity.push_back(zero);
+	aceleration.push_back(zero);
+	dir.push_back(dirFromYaw(0));
+	prevPosition.push_back(p);
+	prevDir.push_back(dirFromYaw(0));
+	yaw.push_back(0);
+	v_yaw.push_back(0);
+	type.push_back(type_);
+	team.push_back(0);
+	recarga.push_back(0);
+	disparando.push_back(0);
+	maisProximo.push_back(nullHandle());
+	iteracaoMaisProximo.push_back(-1);
+	cold.push_back(initialCold());
+	body.push_back(m);
+
+	int slot = size() - 1;
+	int index;
+	if(freeIndices.empty())
+	{
+		index = (int) slotOf.size();
+		slotOf.push_back(slot);
+		generation.push_back(0);
+	}
+	else
+	{
+		index = freeIndices.back();
+		freeIndices.pop_back();
+		slotOf[index] = slot;
+	}
+	indexOf.push_back(index);
+	return slot;
+}
+
+void EntityStore::remove(int slot)
+{
+	int last = size() - 1;
+
+	int index = indexOf[slot];
+	generation[index]++;
+	slotOf[index] = -1;
+	freeIndices.push_back(index);
+	if(isRolling(cold[slot])) quantRolando--;
+
+	if(slot != last)
+	{
+		position[slot] = position[last];
+		velocity[slot] = velocity[last];
+		aceleration[slot] = aceleration[last];
+		dir[slot] = dir[last];
+		prevPosition[slot] = prevPosition[last];
+		prevDir[slot] = prevDir[last];
+		yaw[slot] = yaw[last];
+		v_yaw[slot] = v_yaw[last];
+		type[slot] = type[last];
+		team[slot] = team[last];
+		recarga[slot] = recarga[last];
+		disparando[slot] = disparando[last];
+		maisProximo[slot] = maisProximo[last];
+		iteracaoMaisProximo[slot] = iteracaoMaisProximo[last];
+		cold[slot] = cold[last];
+		body[slot] = body[last];
+		body[slot]->slot = slot;
+		indexOf[slot] = indexOf[last];
+		slotOf[indexOf[slot]] = slot;
+	}
+	position.pop_back();
+	velocity.pop_back();
+	aceleration.pop_back();
+	dir.pop_back();
+	prevPosition.pop_back();
+	prevDir.pop_back();
+	yaw.pop_back();
+	v_yaw.pop_back();
+	type.pop_back();
+	team.pop_back();
+	recarga.pop_back();
+	disparando.pop_back();
+	maisProximo.pop_back();
+	iteracaoMaisProximo.pop_back();
+	cold.pop_back();
+	body.pop_back();
+	indexOf.pop_back();
+}
+
+EntityHandle EntityStore::handleOf(int slot) const
+{
+	EntityHandle h;
+	h.index = indexOf[slot];
+	h.generation = generation[h.index];
+	return h;
+}
+
+Movable *EntityStore::resolve(const EntityHandle &h) const
+{
+	if(h.index < 0 || h.index >= (int) slotOf.size()) return NULL;
+	if(generation[h.index] != h.generation) return NULL;
+	return body[slotOf[h.index]];
+}
+
+void EntityStore::integrate()
+{
+	integrate(0, size());
+}
+
+void EntityStore::setHeading(int slot, double yaw_)
+{
+	yaw[slot] = yaw_;
+	dir[slot] = prevDir[slot] = dirFromYaw(yaw_);
+}
+
+void EntityStore::setRolling(int slot, float v_roll_, float v_pitch_)
+{
+	EntityCold &c = cold[slot];
+	if(isRolling(c)) quantRolando--;
+	c.v_roll = v_roll_;
+	c.v_pitch = v_pitch_;
+	if(isRolling(c)) quantRolando++;
+}
+
+// Cada etapa percorre uma coluna inteira da faixa com os nucleos de Vector.h.
+void EntityStore::integrate(int begin, int end)
+{
+	const float dt = TIME_STEP/1000.0f;
+	const float atrito = MOVABLE_LINEAR_FRICTION;
+	int n = end - begin;
+	if(n <= 0) return;
+
+	std::copy(position.begin() + begin, position.begin() + end, prevPosition.begin() + begin);
+	std::copy(dir.begin() + begin, dir.begin() + end, prevDir.begin() + begin);
+
+	clampLengths(&velocity[begin], n, MOVABLE_MAX_VELOCITY);
+
+	// Aqui começam os códigos de atualização das variáveis de estado.
+
+	if(quantRolando > 0)
+	{
+		for(int i = begin; i < end; i++)
+		{
+			cold[i].roll += cold[i].v_roll * TIME_STEP/500.0f;
+			cold[i].pitch += cold[i].v_pitch * TIME_STEP/500.0f;
+		}
+	}
+
+	integratePositions(&position[begin], &velocity[begin], n, dt);
+	integrateVelocities(&velocity[begin], &aceleration[begin], n, atrito, dt);
+
+	// Quem nao esta girando nao paga nada aqui.
+	for(int i = begin; i < end; i++)
+	{
+		if(v_yaw[i] == 0) continue;
+
+		float y = yaw[i] + v_yaw[i]*dt;
+		if(y > (float) M_PI) y -= 2*(float) M_PI;
+		else if(y < -(float) M_PI) y += 2*(float) M_PI;
+		yaw[i] = y;
+
+		dir[i] = dirFromYaw(y);
+	}
+}
+
+void EntityStore::writeSnapshot(std::vector<SnapshotEntity> &out) const
+{
+	out.resize(size());
+	for(int i = 0; i < size(); i++)
+	{
+		SnapshotEntity &e = out[i];
+		snapshotStore(e.prevPosition, toVector(prevPosition[i]));
+		snapshotStore(e.position, toVector(position[i]));
+		snapshotStore(e.prevDir, toVector(prevDir[i]));
+		snapshotStore(e.dir, toVector(dir[i]));
+		snapshotStore(e.prevSide, sideFromDir(prevDir[i]));
+		snapshotStore(e.side, sideFromDir(dir[i]));
+		e.type = type[i];
+	}
+}
+
+EntityStore::~EntityStore()
+{
+}
+
+void EntityStore::getColunas(Coluna *out)
+{
+	unsigned int n = size();
+	Coluna c[WORLD_COLUNAS_ENTIDADES] = {
+		{ position.data(), sizeof(Vec2f), n },
+		{ velocity.data(), sizeof(Vec2f), n },
+		{ aceleration.data(), sizeof(Vec2f), n },
+		{ dir.data(), sizeof(Vec2f), n },
+		{ prevPosition.data(), sizeof(Vec2f), n },
+		{ prevDir.data(), sizeof(Vec2f), n },
+		{ yaw.data(), sizeof(float), n },
+		{ v_yaw.data(), sizeof(float), n },
+		{ type.data(), sizeof(unsigned char), n },
+		{ team.data(), sizeof(int), n },
+		{ cold.data(), sizeof(EntityCold), n },
+	};
+	for(int i = 0; i < WORLD_COLUNAS_ENTIDADES; i++)
+	{
+		out[i] = c[i];
+	}
+}
+
+void EntityStore::restoreColunas()
+{
+	quantRolando = 0;
+	for(int i = 0; i < size(); i++)
+	{
+		if(isRolling(cold[i])) quantRolando++;
+	}
+}
@@ -0,0 +1,136 @@
+/*
+ * EntityStore.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef ENTITYSTORE_H_
+#define ENTITYSTORE_H_
+
+#include <vector>
+#include "Vector.h"
+#include "Constants.h"
+#include "RenderSnapshot.h"
+#include "WorldFile.h"
+
+// Tag de tipo de cada slot. As fases quentes despacham por ela, em lotes de um
+// tipo so, em vez de chamadas virtuais ou dynamic_cast.
+#define ENTITY_TANK 0     // Agent (o jogador).
+#define ENTITY_PROJETIL 1
+#define ENTITY_INIMIGO 2  // Enemy; desenhado como ENTITY_TANK.
+#define ENTITY_TIPOS 3
+
+namespace std {
+class Movable;
+class Agent;
+}
+
+// Referencia estavel para um corpo: continua valida enquanto o corpo existir e
+// passa a resolver para NULL assim que ele e removido (a geracao muda).
+typedef struct EntityHandle {
+	int index;
+	unsigned int generation;
+} EntityHandle;
+
+EntityHandle nullHandle();
+
+// O que quase nunca e lido: roll/pitch (ninguem gira fora do plano hoje) e a
+// materia de cada corpo. Fica numa tabela a parte, fora das linhas quentes.
+typedef struct EntityCold {
+	float roll, pitch;
+	float v_roll, v_pitch;
+	float mass, charge;
+} EntityCold;
+
+// Bytes por corpo nas colunas que a integracao percorre: posicao, velocidade,
+// aceleracao, dir, posicao e dir anteriores, yaw e v_yaw. Cabem numa linha de cache.
+#define ENTITY_BYTES_INTEGRACAO (6*sizeof(Vec2f) + 2*sizeof(float))
+static_assert(ENTITY_BYTES_INTEGRACAO <= 64, "a linha de integracao de um corpo deve caber numa linha de cache");
+// As colunas da decisao: tipo, time, recarga, disparo pendente e o alvo mais
+// proximo com a iteracao em que foi calculado.
+#define ENTITY_BYTES_DECISAO (2*sizeof(unsigned char) + 3*sizeof(int) + sizeof(EntityHandle))
+// O resto por corpo: a linha fria, o ponteiro para o corpo e o slot map.
+#define ENTITY_BYTES_RESTO (sizeof(EntityCold) + sizeof(void *) + 3*sizeof(int))
+
+// Estado cinematico de todos os corpos do jogo em vetores contiguos (SoA).
+// Cada Movable e apenas uma visao (store, slot) para uma linha destas colunas;
+// a remocao troca a ultima linha para o buraco e avisa o Movable dono dela.
+// Por cima das colunas densas ha um slot map (indice -> slot, com geracao)
+// que da os EntityHandle.
+class EntityStore {
+private:
+	std::vector<Vec2f> position;
+	std::vector<Vec2f> velocity;
+	std::vector<Vec2f> aceleration;
+	std::vector<Vec2f> dir; // side e dir girado de -90 graus, nao e guardado.
+
+	// Estado da iteracao anterior, para interpolar o desenho entre dois passos.
+	std::vector<Vec2f> prevPosition;
+	std::vector<Vec2f> prevDir;
+
+	// yaw e o rumo no plano, em radianos: dir e derivado dele e so muda quando
+	// v_yaw != 0.
+	std::vector<float> yaw, v_yaw;
+
+	std::vector<unsigned char> type;
+	std::vector<int> team;
+
+	// Estado de decisao dos Agent, lido e escrito em todo think.
+	std::vector<int> recarga;
+	std::vector<unsigned char> disparando;
+	std::vector<EntityHandle> maisProximo;
+	std::vector<int> iteracaoMaisProximo; // Iteracao em que maisProximo foi calculado.
+
+	std::vector<EntityCold> cold;
+	int quantRolando; // Corpos com v_roll ou v_pitch != 0; com 0 a integracao nem olha 'cold'.
+
+	std::vector<Movable *> body;
+	std::vector<int> indexOf;
+
+	// Slot map: para cada indice, o slot denso atual (-1 se livre) e a geracao.
+	std::vector<int> slotOf;
+	std::vector<unsigned int> generation;
+	std::vector<int> freeIndices;
+
+	friend class std::Movable;
+	friend class std::Agent;
+
+	EntityHandle handleOf(int slot) const;
+	// Muda o rumo e refaz dir, sem interpolar (teleporte).
+	void setHeading(int slot, double yaw_);
+	void setRolling(int slot, float v_roll_, float v_pitch_);
+	static bool isRolling(const EntityCold &c) { return c.v_roll != 0 || c.v_pitch != 0; }
+
+public:
+	EntityStore();
+
+	void reserve(int n);
+	int add(Movable *m, const Vector &pos, int type_);
+	void remove(int slot);
+	int size() const { return (int) body.size(); }
+
+	int getType(int slot) const { return type[slot]; }
+	Movable *getBody(int slot) const { return body[slot]; }
+
+	// NULL se o corpo referenciado ja foi removido.
+	Movable *resolve(const EntityHandle &h) const;
+
+	// Integra todos os corpos de uma vez (antigo Movable::iterate()).
+	void integrate();
+	// Integra apenas os slots [begin, end); faixas disjuntas podem rodar em paralelo.
+	void integrate(int begin, int end);
+
+	// Copia o estado atual e o anterior de todos os corpos; out[i] e o slot i.
+	void writeSnapshot(std::vector<SnapshotEntity> &out) const;
+
+	// As WORLD_COLUNAS_ENTIDADES colunas de estado, para gravar e restaurar o mundo
+	// (ver WorldFile.h). Os corpos e o slot map ficam de fora.
+	void getColunas(Coluna *out);
+	// Refaz o que e derivado das colunas depois de elas serem copiadas por cima.
+	void restoreColunas();
+
+	~EntityStore();
+};
+
+#endif /* ENTITYSTORE_H_ */
@@ -0,0 +1,73 @@
+/*
+ * FrameGovernor.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "FrameGovernor.h"
+#include "GameView.h"
+
+Qualidade qualidadeDoNivel(int nivel)
+{
+	Qualidade q;
+	q.lodDistancia = nivel >= QUALIDADE_LOD_PERTO ? LOD_DISTANCIA/2 : LOD_DISTANCIA;
+	q.ralear = nivel >= QUALIDADE_LOD_RALO ? 2 : 1;
+	q.ceu = q.radar = nivel < QUALIDADE_SEM_ENFEITES;
+	// Com o quadro estourando, esperar o vsync arredonda cada quadro para dois
+	// periodos da tela; sem ele o quadro sai assim que fica pronto.
+	q.swapInterval = nivel < QUALIDADE_SEM_ENFEITES ? 1 : 0;
+	q.ticksPorQuadro = nivel >= QUALIDADE_MEIA_TAXA ? 2 : 0;
+	return q;
+}
+
+FrameGovernor::FrameGovernor(int fps)
+{
+	orcamento = fps > 0 ? 1000000000LL / fps : 0;
+	nivel = QUALIDADE_TOTAL;
+	quadros = 0;
+	somaOcupado = somaDesenho = 0;
+	folgadas = 0;
+	espera = GOVERNO_ESPERA;
+	desdeSubida = -1;
+}
+
+bool FrameGovernor::frame(long long ocupado, long long desenho)
+{
+	if(orcamento == 0) return false;
+
+	somaOcupado += ocupado;
+	somaDesenho += desenho;
+	if(++quadros < GOVERNO_JANELA) return false;
+
+	long long mediaOcupado = somaOcupado / quadros;
+	long long mediaDesenho = somaDesenho / quadros;
+	quadros = 0;
+	somaOcupado = somaDesenho = 0;
+	if(desdeSubida >= 0 && ++desdeSubida > GOVERNO_ESPERA) desdeSubida = -1;
+
+	// Com vsync o tempo ocupado inclui a espera pela tela; so passar do orcamento
+	// quer dizer quadro perdido.
+	if(mediaOcupado > orcamento + orcamento/10)
+	{
+		folgadas = 0;
+		if(desdeSubida >= 0 && espera < GOVERNO_ESPERA_MAX) espera *= 2; // A subida nao se sustentou.
+		desdeSubida = -1;
+		if(nivel == QUALIDADE_NIVEIS - 1) return false;
+		nivel++;
+		return true;
+	}
+
+	// Para subir so conta o desenho, que nao inclui a espera pelo vsync.
+	if(nivel > QUALIDADE_TOTAL && mediaDesenho < orcamento/2)
+	{
+		if(++folgadas < espera) return false;
+		folgadas = 0;
+		nivel--;
+		desdeSubida = 0;
+		return true;
+	}
+	folgadas = 0;
+	if(desdeSubida < 0 && espera > GOVERNO_ESPERA) espera--; // Estavel: a espera volta aos poucos.
+	return false;
+}
@@ -0,0 +1,65 @@
+/*
+ * FrameGovernor.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef FRAMEGOVERNOR_H_
+#define FRAMEGOVERNOR_H_
+
+// Niveis de qualidade do desenho, do melhor para o mais barato. Cada um inclui
+// os cortes dos anteriores.
+#define QUALIDADE_TOTAL 0
+#define QUALIDADE_LOD_PERTO 1    // O impostor comeca na metade da distancia.
+#define QUALIDADE_LOD_RALO 2     // Longe, so metade dos impostores.
+#define QUALIDADE_SEM_ENFEITES 3 // Sem ceu nem radar, e sem esperar o vsync.
+#define QUALIDADE_MEIA_TAXA 4    // Um quadro a cada duas iteracoes.
+#define QUALIDADE_NIVEIS 5
+
+#define GOVERNO_JANELA 30      // Quadros por avaliacao.
+#define GOVERNO_ESPERA 4       // Janelas folgadas seguidas antes de subir um nivel.
+#define GOVERNO_ESPERA_MAX 64  // Teto da espera depois de subidas que nao se sustentaram.
+
+// O que o desenho faz em cada nivel.
+typedef struct Qualidade {
+	double lodDistancia;
+	int ralear;        // Alem de 2*lodDistancia, desenha 1 a cada 'ralear' impostores.
+	bool ceu;
+	bool radar;
+	int swapInterval;  // Para window::setSwapInterval().
+	int ticksPorQuadro; // 0: o intervalo minimo e FRAME_STEP; n: n*TIME_STEP.
+} Qualidade;
+
+Qualidade qualidadeDoNivel(int nivel);
+
+// Mede o custo de cada quadro e troca o nivel de qualidade para manter 'fps'
+// quadros por segundo. Desce um nivel quando a media de uma janela passa do
+// orcamento; sobe quando o desenho sozinho cabe com folga em varias janelas
+// seguidas. Uma subida desfeita logo em seguida dobra a espera para a proxima,
+// entao uma maquina no limite nao fica piscando entre dois niveis. So a thread
+// do GL usa.
+class FrameGovernor {
+private:
+	long long orcamento; // ns por quadro; 0: desligado.
+	int nivel;
+	int quadros;
+	long long somaOcupado, somaDesenho;
+	int folgadas;   // Janelas folgadas seguidas.
+	int espera;     // Janelas folgadas necessarias para subir.
+	int desdeSubida; // Janelas desde a ultima subida (-1: nenhuma recente).
+
+public:
+	// fps 0 desliga o governo: qualidade total sempre.
+	FrameGovernor(int fps);
+
+	// Um quadro pronto. 'ocupado': do comeco do quadro ao fim do desenho, com a
+	// troca de buffers; 'desenho': so o desenho. Em ns. Verdadeiro se o nivel mudou.
+	bool frame(long long ocupado, long long desenho);
+
+	int getNivel() const { return nivel; }
+	Qualidade getQualidade() const { return qualidadeDoNivel(nivel); }
+	bool isAtivo() const { return orcamento > 0; }
+};
+
+#endif /* FRAMEGOVERNOR_H_ */
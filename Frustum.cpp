@@ -0,0 +1,86 @@
+/*
+ * Frustum.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "Frustum.h"
+
+Frustum::Frustum()
+{
+	// Sem matriz ainda: tudo visivel.
+	for(int i = 0; i < 6; i++)
+	{
+		planos[i][0] = planos[i][1] = planos[i][2] = 0;
+		planos[i][3] = 1;
+	}
+}
+
+// Gribb e Hartmann: cada plano e a soma ou a diferenca da quarta linha da matriz
+// de recorte com uma das outras tres.
+void Frustum::fromMatrices(const double *projecao, const double *modelview)
+{
+	double m[16];
+	for(int c = 0; c < 4; c++)
+	{
+		for(int l = 0; l < 4; l++)
+		{
+			double s = 0;
+			for(int k = 0; k < 4; k++) s += projecao[k*4 + l]*modelview[c*4 + k];
+			m[c*4 + l] = s;
+		}
+	}
+
+	for(int i = 0; i < 6; i++)
+	{
+		int linha = i/2;
+		double sinal = (i % 2 == 0) ? 1 : -1;
+		for(int k = 0; k < 4; k++)
+		{
+			planos[i][k] = m[k*4 + 3] + sinal*m[k*4 + linha];
+		}
+		double n = sqrt(planos[i][0]*planos[i][0] + planos[i][1]*planos[i][1] + planos[i][2]*planos[i][2]);
+		if(n > 0)
+		{
+			for(int k = 0; k < 4; k++) planos[i][k] /= n;
+		}
+	}
+}
+
+bool Frustum::sphereVisible(const Vector &centro, double raio) const
+{
+	for(int i = 0; i < 6; i++)
+	{
+		const double *p = planos[i];
+		if(p[0]*centro.getX() + p[1]*centro.getY() + p[2]*centro.getZ() + p[3] < -raio) return false;
+	}
+	return true;
+}
+
+int Frustum::boxVisible(const float *min, const float *max) const
+{
+	int resultado = FRUSTUM_DENTRO;
+	for(int i = 0; i < 6; i++)
+	{
+		const double *p = planos[i];
+		// Vertice mais a frente e mais atras da caixa na direcao da normal.
+		double frente = p[3], tras = p[3];
+		for(int k = 0; k < 3; k++)
+		{
+			if(p[k] >= 0)
+			{
+				frente += p[k]*max[k];
+				tras += p[k]*min[k];
+			}
+			else
+			{
+				frente += p[k]*min[k];
+				tras += p[k]*max[k];
+			}
+		}
+		if(frente < 0) return FRUSTUM_FORA;
+		if(tras < 0) resultado = FRUSTUM_PARCIAL;
+	}
+	return resultado;
+}
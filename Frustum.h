@@ -0,0 +1,36 @@
+/*
+ * Frustum.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef FRUSTUM_H_
+#define FRUSTUM_H_
+
+#include "Vector.h"
+
+#define FRUSTUM_FORA 0
+#define FRUSTUM_PARCIAL 1
+#define FRUSTUM_DENTRO 2
+
+// Os seis planos do volume de visao, em coordenadas do mundo, tirados da matriz
+// que o GL realmente usa (projecao vezes modelview), entao valem para qualquer
+// combinacao de gluPerspective, glScalef e gluLookAt.
+class Frustum {
+private:
+	double planos[6][4]; // a, b, c, d com a normal unitaria apontando para dentro.
+
+public:
+	Frustum();
+
+	// Matrizes no formato do glGetDoublev (colunas).
+	void fromMatrices(const double *projecao, const double *modelview);
+
+	bool sphereVisible(const Vector &centro, double raio) const;
+
+	// FRUSTUM_FORA, FRUSTUM_PARCIAL ou FRUSTUM_DENTRO para a caixa [min, max].
+	int boxVisible(const float *min, const float *max) const;
+};
+
+#endif /* FRUSTUM_H_ */
@@ -4,139 +4,98 @@
 #define Height 800
 
 GLuint t[2];
-GLuint tanque[5];
 
 GLfloat mat_specular[] = { 1.0, 1, 1, 1};
 GLfloat mat_shininess[] = { 50.0 };
 GLfloat light_position[4] = { 0.0, 0.0, -10000, 1.0 };
 
-unsigned int getint(FILE *fp)
-{
-  int c, c1, c2, c3;
-
-  // Pega 4 bytes
-  c = getc(fp);
-  c1 = getc(fp);
-  c2 = getc(fp);
-  c3 = getc(fp);
-
-  return ((unsigned int) c) +
-    (((unsigned int) c1) << 8) +
-    (((unsigned int) c2) << 16) +
-    (((unsigned int) c3) << 24);
-}
-
-unsigned int getshort(FILE *fp)
-{
-  int c, c1;
-
-  //Pega 2 bytes
-  c = getc(fp);
-  c1 = getc(fp);
-
-  return ((unsigned int) c) + (((unsigned int) c1) << 8);
-}
-
-int ImageLoad(char *filename, Image *image) {
-    FILE *file;
-    unsigned long size;                 // Tamanho da imagem em bytes.
-    unsigned long i;                    // Contador padrão.
-    unsigned short int planes;          // Numero de planos na imagem (deve ser 1).
-    unsigned short int bpp;             // Numero de bits por pixel (deve ser 24)
-    char temp;                          // Usado para converter cores de bgr para rgb.
-
-    // Certificando-se de que o arquivo está no local.
-    if ((file = fopen(filename, "rb")) == NULL) {
-      printf("Arquivo nao encontrado: %s\n",filename);
-      return 0;
-    }
-
-    // Procura atravez do cabeçalho do bmp, parando nas especificações de width/height:
-    fseek(file, 18, SEEK_CUR);
-
-    // Não foi feita uma verificação rigorosa de erros.
+// Uma textura sendo carregada: o .tex mapeado ou, se nao houver, o BMP lido.
+typedef struct TextureJob {
+    const char *source;
+    GLuint *textura;
+    TexFile tex;
+    Image img;
+} TextureJob;
 
-    // Lendo a largura
-    image->sizeX = getint (file);
-    printf("Largura de %s: %lu\n", filename, image->sizeX);
+static TextureJob jobs[2];
 
-    // Lendo a altura
-    image->sizeY = getint (file);
-    printf("Altura de %s: %lu\n", filename, image->sizeY);
-
-    // Calculo do tamanho (size) (assumindo 24 bits ou 3 bytes por pixel).
-    size = image->sizeX * image->sizeY * 3;
-
-    // Le o numero de planos
-    planes = getshort(file);
-    if (planes != 1) {
-	printf("Planes from %s is not 1: %u\n", filename, planes);
-	return 0;
+// Abre o .tex com o mesmo nome do BMP (ex.: sky.bmp -> sky.tex): ja vem em BGR e
+// com mipmaps, mapeado direto do arquivo. Sem ele le o BMP (mais lento e sem
+// mipmaps). Nao usa GL, pode rodar em qualquer thread.
+static bool decodeTexture(void *ctx)
+{
+    TextureJob *job = (TextureJob *) ctx;
+    job->img.data = NULL;
+    job->tex.mapa = NULL;
+
+    char caminho[256];
+    size_t n = strlen(job->source);
+    if (n >= 4 && n < sizeof(caminho) && strcmp(job->source + n - 4, ".bmp") == 0) {
+	memcpy(caminho, job->source, n - 4);
+	strcpy(caminho + n - 4, ".tex");
+	if (mapTexFile(caminho, &job->tex)) return true;
     }
+    return ImageLoad((char *) job->source, &job->img) != 0;
+}
 
-    // Le o numero de bytes por pixel
-    bpp = getshort(file);
-    if (bpp != 24) {
-      printf("Bpp de %s nao e 24: %u\n", filename, bpp);
-      return 0;
-    }
+// Sobe o que decodeTexture leu para *job->textura e libera a memoria do lado da CPU.
+static void uploadTexture(void *ctx)
+{
+    TextureJob *job = (TextureJob *) ctx;
 
-    // Salta o restante do cabeçalho
-    fseek(file, 24, SEEK_CUR);
+    glBindTexture(GL_TEXTURE_2D, *job->textura);   // Textura 2D (dimensoes x e y)
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR); // reescala linearmente quando a imagem for maior que a textura
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Nem o .tex nem o ImageLoad tem enchimento nas linhas
+
+    if (job->tex.mapa != NULL) {
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	for (unsigned int i = 0; i < job->tex.header->niveis; i++) {
+	    unsigned int w, h;
+	    const unsigned char *pixels = texLevel(&job->tex, i, &w, &h);
+	    glTexImage2D(GL_TEXTURE_2D, i, GL_RGB8, w, h, 0, GL_BGR, GL_UNSIGNED_BYTE, pixels);
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, job->tex.header->niveis - 1);
 
-    // Le os pixels
-    image->data = (char *) malloc(size);
-    if (image->data == NULL) {
-	printf("Erro alocando memoria para informacoes de cor\n");
-	return 0;
+	// O GL ja copiou os pixels; o mapeamento pode sair.
+	unmapTexFile(&job->tex);
+	return;
     }
 
-    if ((i = fread(image->data, size, 1, file)) != 1) {
-	printf("Erro lendo informacoes de cor de %s.\n", filename);
-	return 0;
-    }
+    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR); // idem para quando for menor
 
-    for (i=0;i<size;i+=3) { // reverse all of the colors. (bgr -> rgb)
-	temp = image->data[i];
-	image->data[i] = image->data[i+2];
-	image->data[i+2] = temp;
-    }
-    // Terminamos.
-    return 1;
+    // textura 2D, nivel de detalhe 0 (normal), 3 componentes (vermelho, verde, azul), tamanho x da imagem, tamanho y da imagem,
+    // borda 0 (normal), data (dados) de cores rgb, unsigned byte data, e finalmente os dados propriamente ditos.
+    glTexImage2D(GL_TEXTURE_2D, 0, 3, job->img.sizeX, job->img.sizeY, 0, GL_RGB, GL_UNSIGNED_BYTE, job->img.data);
+    free(job->img.data);
+    job->img.data = NULL;
 }
 
-
-// Não modifique ainda
 GLuint * LoadGLTextures(char *source, GLuint *texture, int pos) {
-    // Carrega textura
-    Image *image1;
-
-    // Aloca espaço para a textura
-    image1 = (Image *) malloc(sizeof(Image));
-
-    if (image1 == NULL){
-		printf("Erro alocando espaco para a imagem\n");
-		exit(0);
-    }
-
-    if (!ImageLoad(source, image1)){
+    TextureJob job;
+    job.source = source;
+    job.textura = &texture[pos];
+    if (!decodeTexture(&job)){
     	exit(1);
     }
 
     // Cria textura
     glGenTextures(1, &texture[pos]);
-    glBindTexture(GL_TEXTURE_2D, texture[pos]);   // Textura 2D (dimensoes x e y)
+    uploadTexture(&job);
+    return texture;
+}
 
-    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR); // reescala linearmente quando a imagem for maior que a textura
-    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR); // idem para quando for menor
+void placeholderTexture(GLuint textura)
+{
+    static const unsigned char cinza[3] = { 128, 128, 128 };
 
-    // textura 2D, nivel de detalhe 0 (normal), 3 componentes (vermelho, verde, azul), tamanho x da imagem, tamanho y da imagem,
-    // borda 0 (normal), data (dados) de cores rgb, unsigned byte data, e finalmente os dados propriamente ditos.
-    glTexImage2D(GL_TEXTURE_2D, 0, 3, image1->sizeX, image1->sizeY, 0, GL_RGB, GL_UNSIGNED_BYTE, image1->data);
-    return texture;
+    glBindTexture(GL_TEXTURE_2D, textura);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, cinza);
 }
 
-void initGl()
+void initGl(AssetLoader *assets)
 {
 	int fudido = 0;
 	glutInit(&fudido,NULL);
@@ -157,30 +116,22 @@ void initGl()
 
 
 
-	// allocate a texture name
-	glGenTextures( 1, t );
-
-	char source1[20] = "texture.bmp";
-	char source2[20] = "sky.bmp";
-
-	int pos = 0;
-	LoadGLTextures(source1, t,pos);				// Carrega uma textura
-
-	pos = 1;
-	LoadGLTextures(source2, t,pos);				// Carrega uma textura
-
-	char t0[20] = "frente.bmp";
-	char t1[20] = "verso.bmp";
-	char t2[20] = "lateralDir.bmp";
-	char t3[20] = "lateralEsq.bmp";
-	char t4[20] = "topo.bmp";
-
-	LoadGLTextures(t0,tanque,0);
-	LoadGLTextures(t1,tanque,1);
-	LoadGLTextures(t2,tanque,2);
-	LoadGLTextures(t3,tanque,3);
-	LoadGLTextures(t4,tanque,4);
+	// Chao e ceu comecam com uma cor so ate o carregador entregar as imagens.
+	static const char *sources[2] = { "texture.bmp", "sky.bmp" };
+	glGenTextures(2, t);
+	for (int i = 0; i < 2; i++) {
+		jobs[i].source = sources[i];
+		jobs[i].textura = &t[i];
+		if (assets != NULL) {
+			placeholderTexture(t[i]);
+			assets->add(decodeTexture, uploadTexture, &jobs[i]);
+		} else {
+			if (!decodeTexture(&jobs[i])) exit(1);
+			uploadTexture(&jobs[i]);
+		}
+	}
 
+	// As faces do tanque vao para o atlas do BatchRenderer.
 
 	glEnable(GL_TEXTURE_2D);			// ativa mapeamento por textura
 
@@ -7,23 +7,21 @@
 #include <GL/glut.h>
 #include <stdarg.h>
 #include "Constants.h"
+#include "Image.h"
+#include "TexFile.h"
+#include "AssetLoader.h"
 
-typedef struct Image_{
-    unsigned long sizeX;
-    unsigned long sizeY;
-    char *data;
-} Image;
+// Carrega source (um BMP) em texture[pos], preferindo o .tex ao lado dele.
+GLuint * LoadGLTextures(char *source, GLuint *texture, int pos);
 
-unsigned int getint(FILE *fp);
 
-unsigned int getshort(FILE *fp);
-int ImageLoad(char *filename, Image *image);
+// Textura de 1x1 cinza, para desenhar enquanto a verdadeira carrega.
+void placeholderTexture(GLuint textura);
 
-GLuint * LoadGLTextures(char *source, GLuint *texture);
-
-
-// Esta funcao deve ser chamada antes de qualquer outra funcao para desenhar na tela
-void initGl();
+// Esta funcao deve ser chamada antes de qualquer outra funcao para desenhar na tela.
+// Com 'assets' as texturas do chao e do ceu entram no carregador e comecam com
+// substitutos; sem ele sao carregadas aqui mesmo.
+void initGl(AssetLoader *assets);
 
 // Desenha uma linha ligando o ponto (x1,y1) ao ponto (x2,y2)
 void drawLine(float x1, float y1, float x2, float y2);
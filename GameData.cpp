@@ -1,136 +1,581 @@
 #include "GameData.h"
+#include "Timer.h"
+#include "Profiler.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <string.h>
 
-extern int level;
+// Tamanho dos pedacos distribuidos entre as threads em cada fase.
+#define THINK_GRAIN 64
+#define INTEGRATE_GRAIN 1024
+#define COLLISION_GRAIN 64
 
 
-GameData::GameData()
+GameData::GameData(int threads, unsigned int semente_) :
+	workers(threads), colisaoGrid(COLLISION_GRID_CELL)
 {
+	semente = semente_;
+	silencioso = false;
 	jogador = NULL;
-	quant = 0;
+	saida = NULL;
+	iteracao = 0;
+	cursorIA = 0;
+	decisoesIA = 0;
+	removidos = 0;
+	jogadoresVivos = 0;
+	quantCampos = 0;
+	estadoJogo = JOGO_ANDAMENTO;
 	control = initializeControl();
 
-	insertPlayer();
-	int quantInimigos = level; // Setado pelo usuário.
+	vizinhosPorThread.resize(workers.getThreads());
+	comandosPorThread.resize(workers.getThreads());
+}
+
+GameData::GameData(int inimigos, int threads, unsigned int semente_, bool jogadorIA) :
+	GameData(threads, semente_)
+{
+	int quantInimigos = inimigos;
+	int quantProjeteis = expectedProjeteis(quantInimigos);
+	store.reserve(1 + quantInimigos);
+	Agent::pool().reserve(jogadorIA ? 0 : 1);
+	Enemy::pool().reserve(quantInimigos + (jogadorIA ? 1 : 0));
+	tiros.reserve(quantProjeteis);
+
+	insertPlayer(jogadorIA);
 	for(int i = 0; i < quantInimigos; i++)
 	{
-		Enemy *e = new Enemy(jogador);
+		Enemy *e = new Enemy(&store, jogador);
 		e->setId(0);
-		e->setPosition(Vector((rand()%100)/4.0 - 25.0,((rand()%100)/4.0 - 25.0),0.0));
-		agents[quant++] = e;
+		double x = (rand_r(&semente)%100)/4.0 - 25.0;
+		double y = (rand_r(&semente)%100)/4.0 - 25.0;
+		e->setPosition(Vector(x, y, 0.0));
 	}
 
 
 }
 
-void GameData::insertPlayer()
+void GameData::insertPlayer(bool ia)
 {
-	jogador = new Agent(Vector(0,0,0.0));
-	jogador->setController(&control);
+	if(ia)
+	{
+		jogador = new Enemy(&store, NULL);
+	}
+	else
+	{
+		jogador = new Agent(&store, Vector(0,0,0.0));
+		jogador->setController(&control);
+	}
 	jogador->setId(PLAYER_ID);
-	agents[quant++] = jogador;
+	jogador->setRadar(true);
 
 	c = Camera(jogador);
-	g = Ground(jogador);
 }
 
-Control *GameData::getControl()
+Agent *GameData::addPlayer(Control *c, const Vector &pos)
 {
-	return &control;
+	Agent *a = new Agent(&store, pos);
+	a->setId(PLAYER_ID);
+	a->setController(c);
+	return a;
 }
 
-void GameData::iterateGameData()
+bool GameData::save(const char *path)
 {
-	Agent *aux;
+	int n = store.size();
+	std::vector<AgentEstado> estados(n);
+	for(int i = 0; i < n; i++)
+	{
+		if(store.getType(i) == ENTITY_INIMIGO) static_cast<Enemy *>(getAgent(i))->saveEstado(estados[i]);
+		else getAgent(i)->saveEstado(estados[i]);
+	}
 
-	g.iterate();
-	c.iterate();
+	Coluna colunas[WORLD_SECOES];
+	store.getColunas(colunas);
+	colunas[WORLD_SECAO_AGENTES].dados = estados.data();
+	colunas[WORLD_SECAO_AGENTES].tamanho = sizeof(AgentEstado);
+	colunas[WORLD_SECAO_AGENTES].quant = n;
+	tiros.getColunas(colunas + WORLD_SECAO_TIROS);
+
+	WorldHeader h;
+	memset(&h, 0, sizeof(h));
+	h.jogador = jogador->getSlot();
+	h.jogadorIA = jogador->getType() == ENTITY_INIMIGO;
+	h.estadoJogo = estadoJogo;
+	h.semente = semente;
+	h.cursorIA = cursorIA;
+	h.iteracao = iteracao;
+	h.decisoesIA = decisoesIA;
+	h.disparos = tiros.getDisparos();
+	h.picoTiros = tiros.getPeak();
+	return writeWorldFile(path, &h, colunas) != 0;
+}
 
-	for(int i = 0; i < quant; i++)
+// Os corpos sao recriados na ordem dos slots gravados, entao cada um cai no mesmo
+// slot de antes; depois as colunas sao copiadas por cima do estado inicial deles.
+// Referencias entre agentes foram gravadas como slots e viram handles novos.
+GameData *GameData::load(const char *path, int threads)
+{
+	WorldFile wf;
+	if(!mapWorldFile(path, &wf)) return NULL;
+	const WorldHeader *h = wf.header;
+	unsigned int agentes = h->secao[WORLD_SECAO_AGENTES].quant;
+	unsigned int tirosGravados = h->secao[WORLD_SECAO_TIROS].quant;
+
+	// Antes de criar qualquer corpo: cada secao tem de ter o tamanho de elemento
+	// deste executavel e a quantidade da sua tabela, dentro do limite. So entao o
+	// teste de limites do mapWorldFile garante que os dados estao no arquivo.
+	EntityStore vazio;
+	ProjectileSystem semTiros;
+	Coluna esperadas[WORLD_SECOES];
+	vazio.getColunas(esperadas);
+	esperadas[WORLD_SECAO_AGENTES].tamanho = sizeof(AgentEstado);
+	semTiros.getColunas(esperadas + WORLD_SECAO_TIROS);
+	bool valido = agentes > 0 && agentes <= WORLD_MAX_CORPOS && tirosGravados <= WORLD_MAX_CORPOS &&
+	              h->jogador >= 0 && h->jogador < (int) agentes;
+	for(int i = 0; valido && i < WORLD_SECOES; i++)
 	{
-		aux = agents[i];
-		aux->iterate();
-		if(aux->checkDisparo())
-		{
-			Projetil *disparo = new Projetil(aux);
+		valido = h->secao[i].tamanho == esperadas[i].tamanho &&
+		         h->secao[i].quant == (i < WORLD_SECAO_TIROS ? agentes : tirosGravados);
+	}
+	if(!valido)
+	{
+		printf("%s nao confere\n", path);
+		unmapWorldFile(&wf);
+		return NULL;
+	}
+	int n = agentes;
+	int quantTiros = tirosGravados;
+
+	GameData *gd = new GameData(threads, h->semente);
+	gd->store.reserve(n);
+	Agent::pool().reserve(h->jogadorIA ? 0 : 1);
+	Enemy::pool().reserve(h->jogadorIA ? n : n - 1);
+	gd->tiros.reserve(std::max(expectedProjeteis(n - 1), quantTiros));
+	for(int i = 0; i < n; i++)
+	{
+		if(i == h->jogador) gd->insertPlayer(h->jogadorIA);
+		else new Enemy(&gd->store, NULL);
+	}
+	gd->tiros.restore(quantTiros, h->disparos, h->picoTiros);
+
+	std::vector<AgentEstado> estados(n);
+	Coluna colunas[WORLD_SECOES];
+	gd->store.getColunas(colunas);
+	colunas[WORLD_SECAO_AGENTES].dados = estados.data();
+	colunas[WORLD_SECAO_AGENTES].tamanho = sizeof(AgentEstado);
+	colunas[WORLD_SECAO_AGENTES].quant = n;
+	gd->tiros.getColunas(colunas + WORLD_SECAO_TIROS);
+
+	int ok = 1;
+	for(int i = 0; ok && i < WORLD_SECOES; i++)
+	{
+		ok = copyWorldSection(&wf, i, colunas[i]);
+	}
+	gd->estadoJogo = h->estadoJogo;
+	gd->cursorIA = h->cursorIA;
+	gd->iteracao = h->iteracao;
+	gd->decisoesIA = h->decisoesIA;
+	int jogadorSlot = h->jogador;
+	bool jogadorIA = h->jogadorIA != 0;
+	unmapWorldFile(&wf); // 'h' deixa de valer.
+	if(!ok)
+	{
+		printf("%s foi gravado por outra versao do jogo\n", path);
+		delete gd;
+		return NULL;
+	}
 
-			disparo->setId(aux->getId());
-			agents[quant++] = disparo;
-		}
-		if(aux->isToDestroy())
-		{
-			if(aux->getId() == PLAYER_ID)
-			{
-				Projetil *isTiro = dynamic_cast<Projetil *>(aux);
-				if (!isTiro)
-				{
-					std::cout << "Game Over: LOSER!" << std::endl;
-					getControl()->keyEsc = TRUE;
-				}
-			}
-			delete aux;
-			agents[i] = agents[quant - 1];
-			--quant;
-			--i;
-		}
+	// As colunas vieram do arquivo: o tipo gravado tem de ser o do corpo recriado
+	// no slot, e toda referencia tem de ser um slot que existe.
+	for(int i = 0; ok && i < n; i++)
+	{
+		int esperado = i == jogadorSlot && !jogadorIA ? ENTITY_TANK : ENTITY_INIMIGO;
+		ok = gd->store.getType(i) == esperado &&
+		     estados[i].maisProximo >= -1 && estados[i].maisProximo < n &&
+		     estados[i].alvo >= -1 && estados[i].alvo < n;
 	}
-	if (1 == quant && jogador == agents[0])
+	if(!ok)
 	{
-		std::cout << "Game Over: WINNER!" << std::endl;
-		getControl()->keyEsc = TRUE;
+		printf("%s nao confere\n", path);
+		delete gd;
+		return NULL;
 	}
+
+	gd->store.restoreColunas();
+	for(int i = 0; i < n; i++)
+	{
+		if(gd->store.getType(i) == ENTITY_INIMIGO) static_cast<Enemy *>(gd->getAgent(i))->restoreEstado(estados[i]);
+		else gd->getAgent(i)->restoreEstado(estados[i]);
+	}
+	return gd;
 }
 
+// Projeteis que os tanques conseguem manter no ar: um tiro vive
+// PROJETIL_RANGE/(velocidade*passo) iteracoes e cada tanque atira no maximo a cada
+// ROUNDS_RECARGA (jogador) ou ROUNDS_RECARGA*ROUNDS_RECARGA_HANDICAP_FOR_IA (IA) iteracoes.
+int GameData::expectedProjeteis(int inimigos)
+{
+	int vidaTiro = (int)(PROJETIL_RANGE / (MOVABLE_MAX_VELOCITY*TIME_STEP/1000.0)) + 1;
+	int tirosJogador = vidaTiro/ROUNDS_RECARGA + 1;
+	int tirosInimigo = vidaTiro/(ROUNDS_RECARGA*ROUNDS_RECARGA_HANDICAP_FOR_IA) + 1;
+	return tirosJogador + inimigos*tirosInimigo;
+}
 
+int *GameData::getJoypad()
+{
+	return control.joypad;
+}
 
-GameData::~GameData()
+Control *GameData::getControl()
 {
-	for(int i = 0; i < quant; i++)
-	{
-		delete agents[i];
-	}
+	return &control;
 }
 
-void GameData::drawGame()
+// Uma iteracao tem duas fases. Na primeira, paralela, cada agente decide (alvo
+// mais proximo, controlAction, alcance do tiro) lendo um mundo que ninguem altera:
+// cada um so escreve no proprio estado. Na segunda, a integracao e as colisoes.
+// Disparos e destruicoes pedidos nas fases vao para buffers de comandos e so sao
+// aplicados no fim, em applyCommands(): nenhum vetor muda de tamanho enquanto e
+// percorrido.
+void GameData::iterateGameData()
 {
+	ProfileScope tick("tick", PROF_TICK);
+	long long inicio = telemetryEnabled() ? getMonotonicTime() : 0;
 
+	iteracao++;
+	rebuildGrid();
 
-	glClearColor(0,0,0,0);
+	{
+		ProfileScope ia("ia", PROF_IA);
+		scheduleThinking();
+		workers.parallelFor((int) slotsPorTipo[ENTITY_TANK].size(), THINK_GRAIN, thinkTask<Agent, ENTITY_TANK>, this);
+		workers.parallelFor((int) slotsPorTipo[ENTITY_INIMIGO].size(), THINK_GRAIN, thinkTask<Enemy, ENTITY_INIMIGO>, this);
+	}
 
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	{
+		ProfileScope integracao("integracao", PROF_INTEGRACAO);
+		workers.parallelFor(store.size(), INTEGRATE_GRAIN, integrateTask, this);
+		workers.parallelFor(tiros.size(), INTEGRATE_GRAIN, projectileTask, this);
 
+		// A camera segue o jogador ja na posicao desta iteracao.
+		c.iterate();
+	}
 
+	{
+		ProfileScope colisao("colisao", PROF_COLISAO);
+		detectCollisions();
+		tiros.collideOpposing();
+		tiros.removeDead();
+	}
 
+	applyCommands();
 
-	//glutSolidSphere (0.04, 10, 8);
+	if (estadoJogo == JOGO_ANDAMENTO && 1 == store.size() && jogador == getAgent(0))
+	{
+		estadoJogo = JOGO_VITORIA;
+		if(!silencioso) std::cout << "Game Over: WINNER!" << std::endl;
+		getControl()->keyEsc = TRUE;
+	}
 
-// Preparando pra mexer na camera!
+	if(saida != NULL) publishSnapshot();
+	if(inicio != 0) telemetryTick(getMonotonicTime() - inicio, store.size(), tiros.size(), comandos.getQuantDisparos(), removidos);
+}
 
+// Aplica os comandos da iteracao em lote: primeiro as destruicoes (uma passada
+// de compactacao no EntityStore), depois os disparos. Os buffers das threads sao
+// juntados e os disparos ordenados pelo slot do atirador, entao o resultado nao
+// depende da divisao do trabalho. Um tiro criado aqui sai da posicao do atirador
+// na fase de decisao e so comeca a andar na proxima iteracao.
+void GameData::applyCommands()
+{
+	comandos.clear();
+	for(unsigned int w = 0; w < comandosPorThread.size(); w++)
+	{
+		comandos.take(comandosPorThread[w]);
+	}
 
+	for(int i = 0; i < comandos.getQuantDestruicoes(); i++)
+	{
+		comandos.getDestruicao(i)->destroyNow();
+	}
+	removeDestroyed();
+	removidos = (int) destruidos.size();
+	releaseDestroyed();
 
-	glPushMatrix();
-// Aqui deve entrar o "jogo de Câmera"!!!
+	comandos.sortSpawns();
+	for(int i = 0; i < comandos.getQuantDisparos(); i++)
+	{
+		const ComandoDisparo &d = comandos.getDisparo(i);
+		tiros.spawn(d.posicao, d.dir, d.dono);
+	}
+}
 
+// Decide quais inimigos pensam nesta iteracao. A volta comeca no primeiro que ficou
+// sem orcamento na iteracao anterior, entao ninguem espera mais que uma volta. O
+// orcamento conta decisoes, nao tempo de relogio, para a partida continuar
+// reprodutivel com a mesma semente.
+void GameData::scheduleThinking()
+{
+	int n = store.size();
+	quantCampos = 0;
+	if(n == 0) return;
+	if(cursorIA >= n) cursorIA = 0;
+
+	int orcamento = AI_ORCAMENTO;
+	int primeiroNegado = -1;
+	for(int k = 0; k < n; k++)
+	{
+		int i = (cursorIA + k) % n;
+		if(store.getType(i) != ENTITY_INIMIGO) continue;
+		Enemy *e = static_cast<Enemy *>(getAgent(i));
 
-	c.posiciona();
+		Agent *alvo = e->schedule(this, orcamento);
+		if(e->isPensando())
+		{
+			decisoesIA++;
+			if(alvo != NULL && !e->isCacador()) e->setCampo(fieldFor(alvo));
+		}
+		if(primeiroNegado < 0 && e->isAtrasado()) primeiroNegado = i;
+	}
+	if(primeiroNegado >= 0) cursorIA = primeiroNegado;
+}
 
-// Aqui termina o "jogo de câmera"!!!
+const PursuitField *GameData::fieldFor(const Agent *alvo)
+{
+	for(int i = 0; i < quantCampos; i++)
+	{
+		if(campos[i]->getAlvo() == alvo) return campos[i];
+	}
+	if(quantCampos == (int) campos.size()) campos.push_back(new PursuitField());
+	PursuitField *c = campos[quantCampos++];
+	c->build(alvo, alvo->getPosition());
+	return c;
+}
 
-	g.draw();
-	//c.draw();
+// Um lote so com corpos do tipo T: T::think e chamada direto, sem passar pela
+// tabela virtual, e o laco e o mesmo para todos os elementos.
+template<class T, int TIPO>
+void GameData::thinkTask(int begin, int end, int worker, void *ctx)
+{
+	ProfileScope lote("ia lote");
+	GameData *gd = (GameData *) ctx;
+	CommandBuffer &comandos = gd->comandosPorThread[worker];
+	const std::vector<int> &slots = gd->slotsPorTipo[TIPO];
+	for(int k = begin; k < end; k++)
+	{
+		int i = slots[k];
+		T *aux = static_cast<T *>(gd->getAgent(i));
+		aux->T::think(gd);
+		if(aux->checkDisparo())
+		{
+			comandos.spawn(aux->getPosition(), aux->getDir(), aux->getId(), i);
+		}
+	}
+}
 
+void GameData::integrateTask(int begin, int end, int /*worker*/, void *ctx)
+{
+	((GameData *) ctx)->store.integrate(begin, end);
+}
+
+void GameData::projectileTask(int begin, int end, int /*worker*/, void *ctx)
+{
+	((GameData *) ctx)->tiros.integrate(begin, end);
+}
+
+void GameData::collisionTask(int begin, int end, int worker, void *ctx)
+{
+	ProfileScope lote("colisao lote");
+	GameData *gd = (GameData *) ctx;
+	std::vector<Agent *> &vizinhos = gd->vizinhosPorThread[worker];
+	CommandBuffer &comandos = gd->comandosPorThread[worker];
+
+	for(int i = begin; i < end; i++)
+	{
+		// Teste continuo: o segmento percorrido pelo tiro neste passo, relativo ao
+		// tanque (que tambem andou), contra a esfera de acerto. A busca na grade usa a
+		// posicao final com folga para o que os dois podem ter andado.
+		Vector p0 = gd->tiros.getPrevPosition(i);
+		Vector p1 = gd->tiros.getPosition(i);
+		vizinhos.clear();
+		gd->colisaoGrid.query(p1, PROJETIL_HIT_RADIUS + PROJETIL_STEP + TANK_MAX_STEP, vizinhos);
+		for(unsigned int k = 0; k < vizinhos.size(); k++)
+		{
+			Agent *alvo = vizinhos[k];
+			if(alvo->getId() != gd->tiros.getOwner(i) &&
+			   segmentDistanceSquared(p0 - alvo->getPrevPosition(), p1 - alvo->getPosition())
+			   < PROJETIL_HIT_RADIUS*PROJETIL_HIT_RADIUS)
+			{
+				comandos.destroy(alvo);
+			}
+		}
+	}
+}
+
+// A grade do radar e da IA: os tiros nao estao no EntityStore, so tanques. Na
+// mesma passada os slots sao separados por tipo para a fase de decisao.
+void GameData::rebuildGrid()
+{
+	grid.clear();
+	jogadoresVivos = 0;
+	for(int t = 0; t < ENTITY_TIPOS; t++)
+	{
+		slotsPorTipo[t].clear();
+	}
+	for(int i = 0; i < store.size(); i++)
+	{
+		Agent *a = getAgent(i);
+		if(a->isToDestroy()) continue; // O jogador destruido, que fica no store: nao pensa nem e visto.
+		grid.insert(a);
+		if(a->getId() == PLAYER_ID) jogadoresVivos++;
+		slotsPorTipo[store.getType(i)].push_back(i);
+	}
+	grid.build();
+}
+
+// Fase ampla: os tanques ja movidos vao para uma grade fina e cada tiro testa
+// apenas as celulas vizinhas. Como ninguem e destruido durante a busca, o
+// resultado nao depende da ordem dos agentes no vetor nem da divisao entre threads.
+void GameData::detectCollisions()
+{
+	colisaoGrid.clear();
+	for(int i = 0; i < store.size(); i++)
+	{
+		if(!getAgent(i)->isToDestroy()) colisaoGrid.insert(getAgent(i));
+	}
+	colisaoGrid.build();
+
+	workers.parallelFor(tiros.size(), COLLISION_GRAIN, collisionTask, this);
+}
+
+void GameData::removeDestroyed()
+{
+	for(int i = 0; i < store.size(); i++)
+	{
+		Agent *aux = getAgent(i);
+		if(aux->isToDestroy())
+		{
+			if(aux == jogador)
+			{
+				if(estadoJogo != JOGO_ANDAMENTO) continue;
+				estadoJogo = JOGO_DERROTA;
+				if(!silencioso) std::cout << "Game Over: LOSER!" << std::endl;
+				getControl()->keyEsc = TRUE;
+			}
+			destruidos.push_back(aux);
+		}
+	}
+}
 
-	for(int i = 0; i < quant; i++)
+// A grade ainda aponta para os agentes removidos nesta iteracao, entao eles so
+// sao liberados no fim dela. Quem os referencia por EntityHandle passa a ver NULL.
+void GameData::releaseDestroyed()
+{
+	for(unsigned int i = 0; i < destruidos.size(); i++)
 	{
-		agents[i]->draw();
+		if(destruidos[i] == jogador) continue; // Camera e chao ainda o seguem ate o fim.
+		delete destruidos[i];
 	}
+	destruidos.clear();
+}
 
-	glPopMatrix();
+GameData::~GameData()
+{
+	for(unsigned int i = 0; i < campos.size(); i++)
+	{
+		delete campos[i];
+	}
+	while(store.size() > 0)
+	{
+		delete getAgent(store.size() - 1);
+	}
+}
 
+void GameData::setSnapshotOutput(SnapshotBuffer *out)
+{
+	saida = out;
+	if(saida != NULL) publishSnapshot();
 }
 
+// Agrupa os tanques do snapshot pelas celulas da grade desta iteracao (counting
+// sort, como no SpatialGrid), com a caixa de cada celula calculada das posicoes ja
+// integradas. O desenho testa a caixa uma vez em vez de cada tanque.
+void GameData::writeCells(RenderSnapshot &s)
+{
+	s.celulas.clear();
+	s.ordemCelulas.clear();
 
+	int n = (int) s.entidades.size();
+	int cells = grid.getCellCount();
+	if(cells == 0) return;
 
+	celulaDe.resize(n);
+	inicioCelula.assign(cells + 1, 0);
+	for(int i = 0; i < n; i++)
+	{
+		if(s.entidades[i].type == ENTITY_PROJETIL)
+		{
+			celulaDe[i] = -1;
+			continue;
+		}
+		celulaDe[i] = grid.cellOf(snapshotVector(s.entidades[i].position));
+		inicioCelula[celulaDe[i] + 1]++;
+	}
+	for(int c = 0; c < cells; c++)
+	{
+		inicioCelula[c + 1] += inicioCelula[c];
+	}
 
+	s.ordemCelulas.resize(inicioCelula[cells]);
+	for(int i = 0; i < n; i++)
+	{
+		if(celulaDe[i] >= 0) s.ordemCelulas[inicioCelula[celulaDe[i]]++] = i;
+	}
 
+	// inicioCelula[c] agora e o fim da celula c.
+	int inicio = 0;
+	for(int c = 0; c < cells; c++)
+	{
+		int fim = inicioCelula[c];
+		if(fim == inicio) continue;
 
+		SnapshotCell cel;
+		for(int k = 0; k < 3; k++)
+		{
+			cel.min[k] = s.entidades[s.ordemCelulas[inicio]].position[k];
+			cel.max[k] = cel.min[k];
+		}
+		for(int j = inicio; j < fim; j++)
+		{
+			const SnapshotEntity &e = s.entidades[s.ordemCelulas[j]];
+			for(int k = 0; k < 3; k++)
+			{
+				cel.min[k] = std::min(cel.min[k], std::min(e.position[k], e.prevPosition[k]));
+				cel.max[k] = std::max(cel.max[k], std::max(e.position[k], e.prevPosition[k]));
+			}
+		}
+		cel.inicio = inicio;
+		cel.quant = fim - inicio;
+		s.celulas.push_back(cel);
+		inicio = fim;
+	}
+}
 
+void GameData::publishSnapshot()
+{
+	RenderSnapshot &s = saida->getEscrita();
+
+	store.writeSnapshot(s.entidades);
+	tiros.writeSnapshot(s.entidades);
+	writeCells(s);
+	s.estadoJogo = estadoJogo;
+	s.jogador = jogador->getSlot();
+	Agent *alvo = jogador->getMaisProximo();
+	s.alvoRadar = alvo ? alvo->getSlot() : -1;
+	snapshotStore(s.prevOlho, c.getPrevPosition());
+	snapshotStore(s.olho, c.getPosition());
+	snapshotStore(s.up, c.getUp());
+	s.tempo = getMonotonicTime();
+
+	saida->publish();
+}
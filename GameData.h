@@ -6,13 +6,18 @@
 #include "Control.h"
 #include <stdlib.h>
 #include "Agent.h"
-#include "Ground.h"
 #include "GLDraw.h"
 #include "Camera.h"
 #include <list>
 #include <vector>
-#include "Projetil.h"
+#include "ProjectileSystem.h"
 #include "Enemy.h"
+#include "SpatialGrid.h"
+#include "EntityStore.h"
+#include "ThreadPool.h"
+#include "RenderSnapshot.h"
+#include "CommandBuffer.h"
+#include "PursuitField.h"
 
 extern GLfloat mat_specular[];
 extern GLfloat mat_shininess[];
@@ -21,24 +26,84 @@ extern GLfloat light_position[];
 class GameData
 {
 private:
+	EntityStore store; // Deve ser o primeiro membro: os agentes sao destruidos antes dele.
+	ThreadPool workers;
 	Control control;
 	Agent *jogador;
-	Agent *agents[4000];
-	int quant;
-	Ground g;
 	Camera c;
 	int estadoJogo;
+	SpatialGrid grid;
+	SpatialGrid colisaoGrid;
+	ProjectileSystem tiros;
+	CommandBuffer comandos; // Os da iteracao inteira, juntados de 'comandosPorThread'.
+	std::vector<Agent *> destruidos;
+	SnapshotBuffer *saida;
+	long iteracao;
+	unsigned int semente; // Gerador do proprio mundo (rand_r), nao o global do rand().
+	bool silencioso;      // Nao imprime o fim da partida.
+	int cursorIA;      // Onde a agenda da IA comeca a proxima volta.
+	long decisoesIA;   // Decisoes de inimigos tomadas desde o inicio.
+	int removidos;     // Tanques removidos na ultima iteracao.
+	int jogadoresVivos; // Tanques do time do jogador na grade desta iteracao.
+	std::vector<int> slotsPorTipo[ENTITY_TIPOS]; // Lotes de um tipo so para a fase de decisao.
+	std::vector<PursuitField *> campos; // Um por alvo seguido; so os 'quantCampos' primeiros valem.
+	int quantCampos;
+	std::vector<int> celulaDe;     // Para agrupar o snapshot pelas celulas de 'grid'.
+	std::vector<int> inicioCelula;
+
+	// Buffers de cada thread: vizinhos na colisao e os comandos pedidos nas fases.
+	std::vector< std::vector<Agent *> > vizinhosPorThread;
+	std::vector<CommandBuffer> comandosPorThread;
+
+	// So o que e comum aos dois jeitos de criar um mundo; nenhum corpo.
+	GameData(int threads, unsigned int semente);
+	static int expectedProjeteis(int inimigos);
+	template<class T, int TIPO> static void thinkTask(int begin, int end, int worker, void *ctx);
+	static void integrateTask(int begin, int end, int worker, void *ctx);
+	static void projectileTask(int begin, int end, int worker, void *ctx);
+	static void collisionTask(int begin, int end, int worker, void *ctx);
+	void rebuildGrid();
+	void scheduleThinking();
+	// O campo de 'alvo' nesta iteracao, montado na primeira vez que alguem pede.
+	const PursuitField *fieldFor(const Agent *alvo);
+	void detectCollisions();
+	void applyCommands();
+	void removeDestroyed();
+	void releaseDestroyed();
+	void publishSnapshot();
+	void writeCells(RenderSnapshot &s);
 
 
 public:
 	int *getJoypad();
-	GameData();
-	void insertPlayer();
+	// Nada global: cada GameData tem seus agentes, threads e gerador, entao varios
+	// podem rodar ao mesmo tempo, um por thread. threads <= 0 usa todos os nucleos.
+	// Com jogadorIA o jogador e um Enemy cacador em vez de seguir o Control.
+	GameData(int inimigos, int threads, unsigned int semente, bool jogadorIA = false);
+	void insertPlayer(bool ia);
+	// Mais um tanque do time do jogador, guiado por 'c' (um cliente do servidor).
+	Agent *addPlayer(Control *c, const Vector &pos);
+	// Grava o mundo como esta no fim da iteracao atual (ver WorldFile.h).
+	bool save(const char *path);
+	// Um mundo gravado por save() que continua do ponto onde foi gravado, iteracao
+	// por iteracao como o original. NULL se o arquivo nao existe ou nao confere.
+	static GameData *load(const char *path, int threads);
+	void setSilencioso(bool s) { silencioso = s; }
 	Control *getControl();
 	void iterateGameData();
-	void drawGame();
-	int getQuant(){return quant;}
-	Agent **getAgents() { return agents; }
+	// A partir daqui cada iteracao publica um RenderSnapshot em 'out' (NULL desliga).
+	void setSnapshotOutput(SnapshotBuffer *out);
+	int getQuant() const { return store.size(); }
+	// Tanques e tiros.
+	int getQuantEntidades() const { return store.size() + tiros.size(); }
+	int getEstadoJogo() const { return estadoJogo; }
+	Agent *getAgent(int i) const { return static_cast<Agent *>(store.getBody(i)); }
+	Agent *getAgent(const EntityHandle &h) const { return resolveAgent(&store, h); }
+	const SpatialGrid *getGrid() const { return &grid; }
+	int getJogadoresVivos() const { return jogadoresVivos; }
+	const ProjectileSystem *getTiros() const { return &tiros; }
+	long getIteracao() const { return iteracao; }
+	long getDecisoesIA() const { return decisoesIA; }
 	~GameData();
 
 };
@@ -0,0 +1,162 @@
+/*
+ * GameView.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "GameView.h"
+#include "Camera.h"
+#include "EntityStore.h"
+#include "Profiler.h"
+
+GameView::GameView(AssetLoader *assets)
+{
+	desenhados = simplificados = 0;
+	setNivel(QUALIDADE_TOTAL);
+	renderer.load(assets);
+}
+
+void GameView::setNivel(int nivel_)
+{
+	nivel = nivel_;
+	qualidade = qualidadeDoNivel(nivel);
+}
+
+// Poe 'e', a entidade 'indice' do snapshot, no lote se estiver visivel ('testar'
+// falso quando a celula dele ja esta inteira dentro do volume de visao).
+void GameView::addEntity(const SnapshotEntity &e, int indice, double alpha, bool testar)
+{
+	Vector up(0,0,1);
+	Vector pos = snapshotLerp(e.prevPosition, e.position, alpha);
+	double raio = e.type == ENTITY_PROJETIL ? RAIO_PROJETIL : RAIO_TANQUE;
+	if(testar && !frustum.sphereVisible(pos, raio)) return;
+
+	double d2 = (pos - olho).getLengthSquared();
+	double lod2 = qualidade.lodDistancia*qualidade.lodDistancia;
+	// Ralear pelo indice, e nao pela ordem da visita: a ordem muda com o volume de
+	// visao e com as celulas, e cada quadro sumiria com tanques diferentes.
+	if(e.type != ENTITY_PROJETIL && d2 > 4*lod2 && indice % qualidade.ralear != 0) return;
+
+	Vector dir = snapshotLerpDir(e.prevDir, e.dir, alpha);
+	Vector side = snapshotLerpDir(e.prevSide, e.side, alpha);
+	desenhados++;
+
+	if(e.type == ENTITY_PROJETIL)
+	{
+		renderer.addProjetil(pos, dir, side, up);
+	}
+	else if(d2 > lod2)
+	{
+		renderer.addTankImpostor(pos, up, olho);
+		simplificados++;
+	}
+	else
+	{
+		renderer.addTank(pos, dir, side, up);
+	}
+}
+
+void GameView::draw(const RenderSnapshot &s, double alpha)
+{
+	glClearColor(0,0,0,0);
+
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	if(s.jogador < 0) return; // Nada publicado ainda.
+
+	const SnapshotEntity &jogador = s.entidades[s.jogador];
+	Vector centro = snapshotLerp(jogador.prevPosition, jogador.position, alpha);
+	Vector up(0,0,1);
+	olho = snapshotLerp(s.prevOlho, s.olho, alpha);
+
+	glPushMatrix();
+
+	Camera::posiciona(olho, centro, snapshotVector(s.up));
+
+	double projecao[16], modelview[16];
+	glGetDoublev(GL_PROJECTION_MATRIX, projecao);
+	glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
+	frustum.fromMatrices(projecao, modelview);
+
+	chao.setPosition(centro);
+	chao.setCeu(qualidade.ceu);
+	chao.draw();
+
+	renderer.begin();
+	desenhados = simplificados = 0;
+
+	// Tanques por celula da grade: uma celula fora do volume de visao sai inteira,
+	// e uma inteira dentro dispensa o teste de cada tanque.
+	for(unsigned int c = 0; c < s.celulas.size(); c++)
+	{
+		const SnapshotCell &cel = s.celulas[c];
+		float min[3], max[3];
+		for(int k = 0; k < 3; k++)
+		{
+			min[k] = cel.min[k] - RAIO_TANQUE;
+			max[k] = cel.max[k] + RAIO_TANQUE;
+		}
+		int visivel = frustum.boxVisible(min, max);
+		if(visivel == FRUSTUM_FORA) continue;
+
+		for(int j = cel.inicio; j < cel.inicio + cel.quant; j++)
+		{
+			int i = s.ordemCelulas[j];
+			addEntity(s.entidades[i], i, alpha, visivel == FRUSTUM_PARCIAL);
+		}
+	}
+	for(unsigned int i = 0; i < s.entidades.size(); i++)
+	{
+		if(s.entidades[i].type == ENTITY_PROJETIL) addEntity(s.entidades[i], i, alpha, true);
+	}
+
+	if(s.alvoRadar >= 0 && qualidade.radar)
+	{
+		const SnapshotEntity &alvo = s.entidades[s.alvoRadar];
+		renderer.addRadar(centro, snapshotLerpDir(jogador.prevDir, jogador.dir, alpha), up,
+		                  snapshotLerp(alvo.prevPosition, alvo.position, alpha));
+	}
+	renderer.flush();
+
+	glPopMatrix();
+
+	if(profilerEnabled()) drawProfiler((int) s.entidades.size());
+}
+
+// Tempos das ultimas PROF_HISTORICO iteracoes, no canto da tela.
+void GameView::drawProfiler(int entidades)
+{
+	glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+	glDisable(GL_LIGHTING);
+	glDisable(GL_TEXTURE_2D);
+	glDisable(GL_DEPTH_TEST);
+
+	// Coordenadas de tela de -1 a 1.
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
+	glColor3f(1, 1, 0);
+	float y = 0.95f;
+	drawText(-0.97f, y, (char *) "entidades %d, desenhadas %d (%d simplificadas)",
+	         entidades, desenhados, simplificados);
+	y -= 0.05f;
+	drawText(-0.97f, y, (char *) "qualidade %d de %d", QUALIDADE_NIVEIS - 1 - nivel, QUALIDADE_NIVEIS - 1);
+	for(int i = 0; i < PROF_SECOES; i++)
+	{
+		double media, maximo;
+		profilerStats(i, &media, &maximo);
+		y -= 0.05f;
+		drawText(-0.97f, y, (char *) "%-10s %6.2f ms  max %6.2f ms", profilerSectionName(i), media, maximo);
+	}
+
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopAttrib();
+}
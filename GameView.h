@@ -0,0 +1,49 @@
+/*
+ * GameView.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef GAMEVIEW_H_
+#define GAMEVIEW_H_
+
+#include "RenderSnapshot.h"
+#include "BatchRenderer.h"
+#include "Ground.h"
+#include "Frustum.h"
+#include "FrameGovernor.h"
+
+// Alem desta distancia da camera o tanque vira um quad so, virado para ela.
+#define LOD_DISTANCIA 6.0
+// Raios das esferas que envolvem cada desenho, para o teste de visibilidade.
+#define RAIO_TANQUE 0.3
+#define RAIO_PROJETIL 0.45
+
+// Desenha um quadro a partir de um RenderSnapshot. Roda na thread do GL e nao
+// toca em nada da simulacao.
+class GameView {
+private:
+	BatchRenderer renderer;
+	Ground chao;
+	Frustum frustum;
+	Vector olho;
+	int desenhados;
+	int simplificados;
+	Qualidade qualidade;
+	int nivel;
+
+	void addEntity(const SnapshotEntity &e, int indice, double alpha, bool testar);
+	void drawProfiler(int entidades);
+
+public:
+	// As texturas do tanque entram em 'assets'.
+	GameView(AssetLoader *assets);
+
+	// alpha: fracao do passo seguinte ja decorrida desde a publicacao do snapshot.
+	void draw(const RenderSnapshot &s, double alpha);
+	// Nivel do FrameGovernor para os proximos quadros.
+	void setNivel(int nivel_);
+};
+
+#endif /* GAMEVIEW_H_ */
@@ -9,62 +9,38 @@
 extern GLuint t[2];
 
 Ground::Ground() {
-	tracked = NULL;
+	ceu = true;
 
 }
 
-Ground::Ground(Agent *a) {
-	tracked = a;
+void Ground::draw()
+{
+	double aresta;
+	Vector centro = position;
 
-}
+	// O chao vem em pedacos em volta do centro; o ceu segue o centro.
+	terreno.draw(centro);
+	if(!ceu) return;
 
-void Ground::iterate()
-{
-	position = tracked->getPosition();
-}
+	glTranslatef(centro.getX(),centro.getY(),centro.getZ());
 
-void Ground::draw()
-{
-	// begin drawing a cube
-	double aresta = 60;
+	aresta = 100;
 
-	glBindTexture(GL_TEXTURE_2D, t[0]);   // Escolhe a textura a ser usada.
-		glBegin(GL_QUADS);
-		glColor4f(1,1,1,0);
+	glBindTexture(GL_TEXTURE_2D, t[1]);   // Escolhe a textura a ser usada.
+	glBegin(GL_QUADS);		                // begin drawing a cube
 		glNormal3f(0,0,1);
-		glTexCoord2f(0.0f, 0.0f); glVertex3f(-aresta, -aresta,  0);	// Bottom Left Of The Texture and Quad
+		glTexCoord2f(0.0f, 0.0f); glVertex3f(-aresta, -aresta,  5);	// Bottom Left Of The Texture and Quad
 
 		glNormal3f(0,0,1);
-		glTexCoord2f(1.0f, 0.0f); glVertex3f( aresta, -aresta,  0);	// Bottom Right Of The Texture and Quad
+		glTexCoord2f(1.0f, 0.0f); glVertex3f( aresta, -aresta,  5);	// Bottom Right Of The Texture and Quad
 
 		glNormal3f(0,0,1);
-		glTexCoord2f(1.0f, 1.0f); glVertex3f( aresta,  aresta,  0);	// Top Right Of The Texture and Quad
+		glTexCoord2f(1.0f, 1.0f); glVertex3f( aresta,  aresta,  5);	// Top Right Of The Texture and Quad
 
 		glNormal3f(0,0,1);
-		glTexCoord2f(0.0f, 1.0f); glVertex3f(-aresta,  aresta,  0);	// Top Left Of The Texture and Quad
-		glEnd();
-
-		glTranslatef(tracked->getPosition().getX(),tracked->getPosition().getY(),tracked->getPosition().getZ());
-
-		aresta = 100;
-
-		glBindTexture(GL_TEXTURE_2D, t[1]);   // Escolhe a textura a ser usada.
-		glBegin(GL_QUADS);		                // begin drawing a cube
-			glNormal3f(0,0,1);
-			glTexCoord2f(0.0f, 0.0f); glVertex3f(-aresta, -aresta,  5);	// Bottom Left Of The Texture and Quad
-
-			glNormal3f(0,0,1);
-			glTexCoord2f(1.0f, 0.0f); glVertex3f( aresta, -aresta,  5);	// Bottom Right Of The Texture and Quad
-
-			glNormal3f(0,0,1);
-			glTexCoord2f(1.0f, 1.0f); glVertex3f( aresta,  aresta,  5);	// Top Right Of The Texture and Quad
-
-			glNormal3f(0,0,1);
-			glTexCoord2f(0.0f, 1.0f); glVertex3f(-aresta,  aresta,  5);	// Top Left Of The Texture and Quad
-		glEnd();
-		glTranslatef(-tracked->getPosition().getX(),-tracked->getPosition().getY(),-tracked->getPosition().getZ());
-
-
+		glTexCoord2f(0.0f, 1.0f); glVertex3f(-aresta,  aresta,  5);	// Top Left Of The Texture and Quad
+	glEnd();
+	glTranslatef(-centro.getX(),-centro.getY(),-centro.getZ());
 }
 
 Ground::~Ground() {
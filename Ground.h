@@ -12,18 +12,22 @@
 #include "Movable.h"
 #include "Vector.h"
 #include "Agent.h"
+#include "Terrain.h"
 #include <list>
 
 
 
-class Ground: public oDrawable, public Movable {
+class Ground: public oDrawable {
 private:
-	Agent *tracked;
+	Vector position; // O chao e o ceu ficam centrados aqui.
+	Terrain terreno;
+	bool ceu;
 public:
 	Ground();
-	Ground(Agent *a);
+	void setPosition(const Vector &pos) { position = pos; }
+	// Desligado quando o FrameGovernor corta os enfeites.
+	void setCeu(bool ligado) { ceu = ligado; }
 	void draw();
-	void iterate();
 
 	virtual ~Ground();
 
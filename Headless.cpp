@@ -0,0 +1,125 @@
+/*
+ * Headless.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "Headless.h"
+#include "GameData.h"
+#include "Timer.h"
+#include "Profiler.h"
+#include <algorithm>
+
+
+static double percentil(const std::vector<long long> &ordenado, double p)
+{
+	if(ordenado.empty()) return 0;
+	int i = (int)(p * (ordenado.size() - 1) + 0.5);
+	return ordenado[i] / 1000.0;
+}
+
+static void imprimePool(const char *nome, const Pool &p)
+{
+	printf("  %-9s vivos %d, pico %d, capacidade %d, alocacoes %ld, mallocs %ld\n",
+			nome, p.getLive(), p.getPeak(), p.getCapacity(), p.getAllocations(), p.getSystemAllocations());
+}
+
+int runHeadless(int inimigos, int threads, int ticks, unsigned int seed, InputReplay *replay,
+		const char *carregar, const char *salvar)
+{
+	GameData *gameData;
+	long long inicioCarga = getMonotonicTime();
+	if(carregar != NULL)
+	{
+		gameData = GameData::load(carregar, threads);
+		if(gameData == NULL)
+		{
+			printf("Mundo invalido: %s\n", carregar);
+			return 1;
+		}
+		inimigos = gameData->getQuant() - 1;
+		printf("mundo %s: iteracao %ld, %d entidades, carregado em %.1f ms\n", carregar,
+				gameData->getIteracao(), gameData->getQuantEntidades(), (getMonotonicTime() - inicioCarga) / 1e6);
+	}
+	else
+	{
+		gameData = new GameData(inimigos, threads, seed);
+	}
+	long decisoesAntes = gameData->getDecisoesIA();
+
+	std::vector<long long> duracoes;
+	duracoes.reserve(ticks);
+
+	int entidadesIniciais = gameData->getQuantEntidades();
+	int picoEntidades = entidadesIniciais;
+	long realocacoesAntes = gameData->getTiros()->getRealocacoes();
+
+	long long inicio = getMonotonicTime();
+	for(int t = 0; t < ticks; t++)
+	{
+		if(replay != NULL && !replay->next(gameData->getControl()))
+		{
+			ticks = t;
+			break;
+		}
+		long long t0 = getMonotonicTime();
+		gameData->iterateGameData();
+		duracoes.push_back(getMonotonicTime() - t0);
+
+		if(gameData->getQuantEntidades() > picoEntidades) picoEntidades = gameData->getQuantEntidades();
+	}
+	double total = (getMonotonicTime() - inicio) / 1e9;
+
+	std::vector<long long> ordenado = duracoes;
+	std::sort(ordenado.begin(), ordenado.end());
+
+	const char *estados[] = { "em andamento", "derrota", "vitoria" };
+	// Um mundo carregado nao parte de 'seed': o gerador dele veio do arquivo.
+	if(carregar != NULL) printf("headless: %d inimigos, mundo %s, %d iteracoes em %.3f s\n", inimigos, carregar, ticks, total);
+	else printf("headless: %d inimigos, semente %u, %d iteracoes em %.3f s\n", inimigos, seed, ticks, total);
+	printf("  %.1f iteracoes/s (tempo real: %d/s)\n", total > 0 ? ticks/total : 0.0, 1000/TIME_STEP);
+	printf("  latencia por iteracao: p50 %.1f us, p99 %.1f us, max %.1f us\n",
+			percentil(ordenado, 0.50), percentil(ordenado, 0.99), percentil(ordenado, 1.0));
+	if(replay != NULL)
+	{
+		Vector p = gameData->getAgent(0)->getPosition();
+		printf("  replay: jogador termina em (%.6f, %.6f)\n", p.getX(), p.getY());
+	}
+	printf("  entidades: inicio %d, fim %d, pico %d\n", entidadesIniciais, gameData->getQuantEntidades(), picoEntidades);
+	printf("  estado do jogo: %s\n", estados[gameData->getEstadoJogo()]);
+	printf("  decisoes de IA por iteracao: %.1f\n", ticks > 0 ? (double) (gameData->getDecisoesIA() - decisoesAntes) / ticks : 0.0);
+	imprimePool("agentes", Agent::pool());
+	imprimePool("inimigos", Enemy::pool());
+	printf("  bytes por corpo: %d integracao, %d decisao, %d resto, Agent %d, Enemy %d; total %d (Enemy)\n",
+			(int) ENTITY_BYTES_INTEGRACAO, (int) ENTITY_BYTES_DECISAO, (int) ENTITY_BYTES_RESTO,
+			(int) sizeof(Agent), (int) sizeof(Enemy), (int) ENTITY_BYTES_CORPO(Enemy));
+	const ProjectileSystem *tiros = gameData->getTiros();
+	printf("  %-9s vivos %d, pico %d, capacidade %d, disparos %ld\n", "projeteis",
+			tiros->size(), tiros->getPeak(), tiros->getCapacity(), tiros->getDisparos());
+	printf("  realocacoes de projeteis durante a partida: %ld\n", tiros->getRealocacoes() - realocacoesAntes);
+
+	if(profilerEnabled())
+	{
+		printf("  perfil das ultimas %d iteracoes:\n", PROF_HISTORICO);
+		for(int i = PROF_TICK; i <= PROF_COLISAO; i++)
+		{
+			double media, maximo;
+			profilerStats(i, &media, &maximo);
+			printf("    %-10s media %.3f ms, max %.3f ms\n", profilerSectionName(i), media, maximo);
+		}
+	}
+
+	int r = 0;
+	if(salvar != NULL)
+	{
+		long long t0 = getMonotonicTime();
+		if(gameData->save(salvar))
+			printf("  mundo gravado em %s em %.1f ms\n", salvar, (getMonotonicTime() - t0) / 1e6);
+		else
+			r = 1;
+	}
+
+	delete gameData;
+	return r;
+}
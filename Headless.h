@@ -0,0 +1,23 @@
+/*
+ * Headless.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef HEADLESS_H_
+#define HEADLESS_H_
+
+#include "InputLog.h"
+
+// Roda 'ticks' iteracoes de GameData::iterateGameData() sem janela nem texturas,
+// com 'inimigos' inimigos, 'threads' threads e a semente 'seed', e imprime
+// iteracoes/s, latencia p50/p99 e a quantidade de entidades. A partida continua
+// ate o fim mesmo que alguem venca. Com 'replay' o jogador recebe a entrada
+// gravada, iteracao por iteracao, ate ela acabar (no maximo 'ticks' iteracoes).
+// Com 'carregar' a partida parte do mundo gravado nele em vez de 'inimigos' e
+// 'seed'; com 'salvar' o mundo do fim e gravado ali (ver GameData::save()).
+int runHeadless(int inimigos, int threads, int ticks, unsigned int seed, InputReplay *replay = NULL,
+		const char *carregar = NULL, const char *salvar = NULL);
+
+#endif /* HEADLESS_H_ */
@@ -0,0 +1,129 @@
+/*
+ * Image.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "Image.h"
+#include <stdlib.h>
+#include <string.h>
+
+unsigned int getint(FILE *fp)
+{
+  int c, c1, c2, c3;
+
+  // Pega 4 bytes
+  c = getc(fp);
+  c1 = getc(fp);
+  c2 = getc(fp);
+  c3 = getc(fp);
+
+  return ((unsigned int) c) +
+    (((unsigned int) c1) << 8) +
+    (((unsigned int) c2) << 16) +
+    (((unsigned int) c3) << 24);
+}
+
+unsigned int getshort(FILE *fp)
+{
+  int c, c1;
+
+  //Pega 2 bytes
+  c = getc(fp);
+  c1 = getc(fp);
+
+  return ((unsigned int) c) + (((unsigned int) c1) << 8);
+}
+
+static unsigned int le32(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int) p[3] << 24);
+}
+
+static unsigned int le16(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+int ImageLoad(char *filename, Image *image) {
+    FILE *file;
+    unsigned char cabecalho[54];        // BITMAPFILEHEADER + BITMAPINFOHEADER.
+    unsigned long size;                 // Tamanho da imagem em bytes.
+    unsigned long i;                    // Contador padrão.
+    unsigned short int planes;          // Numero de planos na imagem (deve ser 1).
+    unsigned short int bpp;             // Numero de bits por pixel (deve ser 24)
+    char temp;                          // Usado para converter cores de bgr para rgb.
+
+    // Certificando-se de que o arquivo está no local.
+    if ((file = fopen(filename, "rb")) == NULL) {
+      printf("Arquivo nao encontrado: %s\n",filename);
+      return 0;
+    }
+
+    // O cabecalho inteiro de uma vez, em vez de byte a byte.
+    if (fread(cabecalho, sizeof(cabecalho), 1, file) != 1 || cabecalho[0] != 'B' || cabecalho[1] != 'M') {
+      printf("%s nao e um BMP\n", filename);
+      fclose(file);
+      return 0;
+    }
+
+    image->sizeX = le32(cabecalho + 18);
+    image->sizeY = le32(cabecalho + 22);
+    printf("%s: %lux%lu\n", filename, image->sizeX, image->sizeY);
+
+    // Calculo do tamanho (size) (assumindo 24 bits ou 3 bytes por pixel).
+    size = image->sizeX * image->sizeY * 3;
+
+    // Le o numero de planos
+    planes = le16(cabecalho + 26);
+    if (planes != 1) {
+	printf("Planes from %s is not 1: %u\n", filename, planes);
+	fclose(file);
+	return 0;
+    }
+
+    // Le o numero de bytes por pixel
+    bpp = le16(cabecalho + 28);
+    if (bpp != 24) {
+      printf("Bpp de %s nao e 24: %u\n", filename, bpp);
+      fclose(file);
+      return 0;
+    }
+
+    // Os pixels comecam onde o cabecalho diz (bfOffBits).
+    fseek(file, le32(cabecalho + 10), SEEK_SET);
+
+    // Le os pixels de uma vez. No arquivo cada linha e completada ate um multiplo de
+    // 4 bytes; em memoria as linhas ficam juntas.
+    unsigned long linha = image->sizeX * 3;
+    unsigned long linhaArquivo = (linha + 3) & ~3UL;
+    image->data = (char *) malloc(linhaArquivo * image->sizeY);
+    if (image->data == NULL) {
+	printf("Erro alocando memoria para informacoes de cor\n");
+	fclose(file);
+	return 0;
+    }
+
+    if (fread(image->data, linhaArquivo * image->sizeY, 1, file) != 1) {
+	printf("Erro lendo informacoes de cor de %s.\n", filename);
+	free(image->data);
+	fclose(file);
+	return 0;
+    }
+    fclose(file);
+
+    if (linhaArquivo != linha) {
+	for (i = 1; i < image->sizeY; i++) {
+	    memmove(image->data + i*linha, image->data + i*linhaArquivo, linha);
+	}
+    }
+
+    for (i=0;i<size;i+=3) { // reverse all of the colors. (bgr -> rgb)
+	temp = image->data[i];
+	image->data[i] = image->data[i+2];
+	image->data[i+2] = temp;
+    }
+    // Terminamos.
+    return 1;
+}
@@ -0,0 +1,27 @@
+/*
+ * Image.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef IMAGE_H_
+#define IMAGE_H_
+
+#include <stdio.h>
+
+typedef struct Image_{
+    unsigned long sizeX;
+    unsigned long sizeY;
+    char *data;
+} Image;
+
+unsigned int getint(FILE *fp);
+
+unsigned int getshort(FILE *fp);
+
+// Le um BMP de 24 bits para image->data (RGB, linhas juntas, de baixo para cima).
+// Quem chama libera image->data com free().
+int ImageLoad(char *filename, Image *image);
+
+#endif /* IMAGE_H_ */
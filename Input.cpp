@@ -0,0 +1,140 @@
+/*
+ * Input.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "Input.h"
+#include "Constants.h"
+
+#define INPUT_RING_MASK (INPUT_RING_SIZE - 1)
+
+InputRing::InputRing() : cabeca(0), cauda(0), descartados(0)
+{
+}
+
+bool InputRing::push(const InputEvent &e)
+{
+	unsigned int t = cauda.load(std::memory_order_relaxed);
+	if(t - cabeca.load(std::memory_order_acquire) >= INPUT_RING_SIZE)
+	{
+		descartados++;
+		return false;
+	}
+	eventos[t & INPUT_RING_MASK] = e;
+	cauda.store(t + 1, std::memory_order_release);
+	return true;
+}
+
+bool InputRing::pop(InputEvent &e)
+{
+	unsigned int h = cabeca.load(std::memory_order_relaxed);
+	if(h == cauda.load(std::memory_order_acquire)) return false;
+	e = eventos[h & INPUT_RING_MASK];
+	cabeca.store(h + 1, std::memory_order_release);
+	return true;
+}
+
+static bool contem(const std::vector<int> &v, int code)
+{
+	for(unsigned int i = 0; i < v.size(); i++)
+	{
+		if(v[i] == code) return true;
+	}
+	return false;
+}
+
+void InputRing::drain(Control *control)
+{
+	std::vector<InputEvent> pendentes;
+	pendentes.swap(adiados);
+	for(unsigned int i = 0; i < pendentes.size(); i++)
+	{
+		applyInputEvent(control, pendentes[i]);
+	}
+
+	// Depois que um evento de uma tecla e adiado, os seguintes dela tambem sao,
+	// para a ordem (aperta, solta, aperta) nao terminar com a tecla solta.
+	std::vector<int> apertadas, comAdiados;
+	InputEvent e;
+	while(pop(e))
+	{
+		bool tecla = e.type == INPUT_KEY_PRESS || e.type == INPUT_KEY_RELEASE;
+		bool adiar = tecla && (contem(comAdiados, e.code) ||
+		             (e.type == INPUT_KEY_RELEASE && contem(apertadas, e.code)));
+
+		if(adiar)
+		{
+			adiados.push_back(e);
+			if(!contem(comAdiados, e.code)) comAdiados.push_back(e.code);
+		}
+		else
+		{
+			if(e.type == INPUT_KEY_PRESS) apertadas.push_back(e.code);
+			applyInputEvent(control, e);
+		}
+	}
+}
+
+static void setKey(Control *control, int code, bool pressed)
+{
+	switch(code)
+	{
+		case TURBINE_INC: control->power_inc = pressed; break;
+		case TURBINE_DEC: control->power_dec = pressed; break;
+		case ARROW_UP: control->arrowUp = pressed; break;
+		case ARROW_DOWN: control->arrowDown = pressed; break;
+		case ARROW_RIGHT: control->arrowRight = pressed; break;
+		case ARROW_LEFT: control->arrowLeft = pressed; break;
+		case KEY_SPACE: control->space = pressed; break;
+		case KEY_ESC:
+		{
+			// Sair nao se desfaz: soltar o ESC antes da iteracao nao cancela.
+			if(pressed) control->keyEsc = true;
+		} break;
+	}
+}
+
+void applyInputEvent(Control *control, const InputEvent &e)
+{
+	switch(e.type)
+	{
+		case INPUT_KEY_PRESS: setKey(control, e.code, true); break;
+		case INPUT_KEY_RELEASE: setKey(control, e.code, false); break;
+
+		case INPUT_BUTTON_PRESS:
+		case INPUT_BUTTON_RELEASE:
+		{
+			bool pressed = e.type == INPUT_BUTTON_PRESS;
+			Vector pos(e.x, e.y, 0);
+			if(pressed) control->pressedPos = pos;
+			else control->releasedPos = pos;
+
+			if(e.code == 1)
+			{
+				control->leftPressed = pressed;
+				if(pressed) control->newLeftPressed = true;
+			}
+			else if(e.code == 3)
+			{
+				control->rightPressed = pressed;
+				if(pressed) control->newRightPressed = true;
+			}
+			else if(e.code == 2)
+			{
+				control->scrollPressed = pressed;
+			}
+		} break;
+
+		case INPUT_JOYSTICK:
+		{
+			struct js_event jse;
+			jse.time = 0;
+			jse.number = e.code;
+			jse.value = e.x;
+			jse.type = e.y;
+			decodeJoystickEvent(control->joypad, &jse);
+		} break;
+	}
+}
@@ -0,0 +1,63 @@
+/*
+ * Input.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef INPUT_H_
+#define INPUT_H_
+
+#include <vector>
+#include <atomic>
+#include "Control.h"
+
+#define INPUT_KEY_PRESS 0
+#define INPUT_KEY_RELEASE 1
+#define INPUT_BUTTON_PRESS 2
+#define INPUT_BUTTON_RELEASE 3
+#define INPUT_JOYSTICK 4
+
+// Potencia de 2. Uma iteracao de 20 ms nunca ve perto disso.
+#define INPUT_RING_SIZE 256
+
+typedef struct InputEvent {
+	unsigned char type;
+	int code; // Tecla (keycode do X11), botao do mouse ou numero do eixo/botao do joystick.
+	int x, y; // Posicao do mouse; no joystick, x e o valor e y o tipo do js_event.
+} InputEvent;
+
+// Fila sem trava de um produtor (a thread do X11 e do joystick) para um consumidor (a da
+// simulacao). push() nunca bloqueia: com a fila cheia o evento e descartado e contado.
+class InputRing {
+private:
+	InputEvent eventos[INPUT_RING_SIZE];
+	std::atomic<unsigned int> cabeca; // Proximo a ler (so o consumidor escreve).
+	std::atomic<unsigned int> cauda;  // Proximo a escrever (so o produtor escreve).
+	std::atomic<long> descartados;
+
+	// Soltas de teclas apertadas na mesma drenagem: ficam para a proxima, para
+	// um toque rapido durar pelo menos uma iteracao.
+	std::vector<InputEvent> adiados;
+
+	InputRing(const InputRing &);
+	InputRing &operator=(const InputRing &);
+
+public:
+	InputRing();
+
+	bool push(const InputEvent &e);
+	bool pop(InputEvent &e);
+
+	// Lado do consumidor: aplica em 'control' tudo o que chegou desde a ultima vez.
+	void drain(Control *control);
+
+	long getDescartados() const { return descartados; }
+	// Eventos ainda nao lidos; de qualquer thread, e so uma fotografia.
+	unsigned int getQuant() const { return cauda.load(std::memory_order_relaxed) - cabeca.load(std::memory_order_relaxed); }
+};
+
+// Atualiza o Control com um evento.
+void applyInputEvent(Control *control, const InputEvent &e);
+
+#endif /* INPUT_H_ */
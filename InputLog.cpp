@@ -0,0 +1,138 @@
+/*
+ * InputLog.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "InputLog.h"
+#include "Constants.h"
+#include <string.h>
+
+#define BIT_UP    0
+#define BIT_DOWN  1
+#define BIT_LEFT  2
+#define BIT_RIGHT 3
+#define BIT_SPACE 4
+#define BIT_JOYPAD 5 // Mais JOYPAD_BUTTONS bits, um por botao.
+
+unsigned int packControl(const Control *c)
+{
+	unsigned int bits = 0;
+	if(c->arrowUp) bits |= 1u << BIT_UP;
+	if(c->arrowDown) bits |= 1u << BIT_DOWN;
+	if(c->arrowLeft) bits |= 1u << BIT_LEFT;
+	if(c->arrowRight) bits |= 1u << BIT_RIGHT;
+	if(c->space) bits |= 1u << BIT_SPACE;
+	for(int i = 0; i < JOYPAD_BUTTONS; i++)
+	{
+		if(c->joypad[i]) bits |= 1u << (BIT_JOYPAD + i);
+	}
+	return bits;
+}
+
+void unpackControl(unsigned int bits, Control *c)
+{
+	c->arrowUp = (bits >> BIT_UP) & 1;
+	c->arrowDown = (bits >> BIT_DOWN) & 1;
+	c->arrowLeft = (bits >> BIT_LEFT) & 1;
+	c->arrowRight = (bits >> BIT_RIGHT) & 1;
+	c->space = (bits >> BIT_SPACE) & 1;
+	for(int i = 0; i < JOYPAD_BUTTONS; i++)
+	{
+		c->joypad[i] = (bits >> (BIT_JOYPAD + i)) & 1;
+	}
+}
+
+InputRecorder::InputRecorder()
+{
+	f = NULL;
+	atual.bits = 0;
+	atual.iteracoes = 0;
+}
+
+bool InputRecorder::open(const char *path, unsigned int semente, int inimigos)
+{
+	close();
+	f = fopen(path, "wb");
+	if(f == NULL) return false;
+
+	InputLogHeader h;
+	memcpy(h.magic, INPUTLOG_MAGIC, 4);
+	h.semente = semente;
+	h.inimigos = inimigos;
+	h.passo = TIME_STEP;
+	fwrite(&h, sizeof(h), 1, f);
+	atual.bits = 0;
+	atual.iteracoes = 0;
+	return true;
+}
+
+void InputRecorder::record(const Control *c)
+{
+	if(f == NULL) return;
+	unsigned int bits = packControl(c);
+	if(atual.iteracoes > 0 && bits != atual.bits)
+	{
+		fwrite(&atual, sizeof(atual), 1, f);
+		atual.iteracoes = 0;
+	}
+	atual.bits = bits;
+	atual.iteracoes++;
+}
+
+void InputRecorder::close()
+{
+	if(f == NULL) return;
+	if(atual.iteracoes > 0) fwrite(&atual, sizeof(atual), 1, f);
+	fclose(f);
+	f = NULL;
+}
+
+InputRecorder::~InputRecorder()
+{
+	close();
+}
+
+InputReplay::InputReplay()
+{
+	memset(&header, 0, sizeof(header));
+	corrida = 0;
+	usadas = 0;
+	total = 0;
+}
+
+bool InputReplay::load(const char *path)
+{
+	FILE *f = fopen(path, "rb");
+	if(f == NULL) return false;
+
+	bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+	          memcmp(header.magic, INPUTLOG_MAGIC, 4) == 0 && header.passo == TIME_STEP;
+	corridas.clear();
+	total = 0;
+	InputRun r;
+	while(ok && fread(&r, sizeof(r), 1, f) == 1)
+	{
+		corridas.push_back(r);
+		total += r.iteracoes;
+	}
+	fclose(f);
+	corrida = 0;
+	usadas = 0;
+	return ok;
+}
+
+bool InputReplay::next(Control *c)
+{
+	while(corrida < corridas.size() && usadas >= corridas[corrida].iteracoes)
+	{
+		corrida++;
+		usadas = 0;
+	}
+	if(corrida >= corridas.size()) return false;
+
+	unpackControl(corridas[corrida].bits, c);
+	usadas++;
+	return true;
+}
@@ -0,0 +1,75 @@
+/*
+ * InputLog.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef INPUTLOG_H_
+#define INPUTLOG_H_
+
+#include <stdio.h>
+#include <vector>
+#include "Control.h"
+
+// Formato .inp: o Control de cada iteracao reduzido aos bits que o jogo usa
+// (setas, espaco e os botoes do joystick), em corridas (bits, iteracoes). Com a
+// semente e a quantidade de inimigos do cabecalho a partida inteira e refeita
+// igual, sem janela e na velocidade que a maquina aguentar.
+#define INPUTLOG_MAGIC "INP1"
+
+typedef struct InputLogHeader {
+	char magic[4];
+	unsigned int semente;
+	int inimigos;
+	int passo;        // TIME_STEP da gravacao; outro passo daria outra partida.
+} InputLogHeader;
+
+typedef struct InputRun {
+	unsigned int bits;
+	unsigned int iteracoes;
+} InputRun;
+
+unsigned int packControl(const Control *c);
+// So mexe nos campos que packControl guarda.
+void unpackControl(unsigned int bits, Control *c);
+
+// Grava uma corrida por vez, quando o estado muda (e a ultima no close()).
+class InputRecorder {
+private:
+	FILE *f;
+	InputRun atual;
+
+	InputRecorder(const InputRecorder &);
+	InputRecorder &operator=(const InputRecorder &);
+
+public:
+	InputRecorder();
+	// Falso se o arquivo nao pode ser criado.
+	bool open(const char *path, unsigned int semente, int inimigos);
+	// Uma chamada por iteracao, com o Control que ela vai usar.
+	void record(const Control *c);
+	void close();
+	~InputRecorder();
+};
+
+class InputReplay {
+private:
+	InputLogHeader header;
+	std::vector<InputRun> corridas;
+	unsigned int corrida;
+	unsigned int usadas; // Iteracoes ja consumidas da corrida atual.
+	long total;
+
+public:
+	InputReplay();
+	// Le o arquivo inteiro. Falso se ele nao existe ou nao confere.
+	bool load(const char *path);
+	unsigned int getSemente() const { return header.semente; }
+	int getInimigos() const { return header.inimigos; }
+	long getIteracoes() const { return total; }
+	// Poe em 'c' a entrada da proxima iteracao. Falso quando a gravacao acabou.
+	bool next(Control *c);
+};
+
+#endif /* INPUTLOG_H_ */
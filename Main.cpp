@@ -3,180 +3,394 @@
 #include "Timer.h"
 #include "GameData.h"
 #include "Camera.h"
+#include "Headless.h"
+#include "GameView.h"
+#include "Input.h"
+#include "Debug.h"
+#include "AssetLoader.h"
+#include "Profiler.h"
+#include "InputLog.h"
+#include "Server.h"
+#include "NetClient.h"
+#include "FrameGovernor.h"
+#include "Telemetry.h"
+#include <unistd.h>
+#include <poll.h>
+#include <thread>
+#include <atomic>
 
 void mouseFunc(int type, int button, int x, int y);
 void keyPress(int code);
 void keyRelease(int code);
 
 void processLogic();
-GameData* gameData;
+void simulationLoop();
+bool processInput();
+void waitInput(long long ns);
+static void enfileira(unsigned char type, int code, int x, int y);
+static GameData *gameData; // O mundo da janela; outros modulos o recebem por parametro.
 window *w;
-int level;
+
+// A simulacao roda em uma thread propria e publica snapshots; esta thread cuida
+// do X11 e do GL. Os eventos de entrada passam de uma para a outra por 'entrada'.
+SnapshotBuffer snapshots;
+InputRing entrada;
+InputRecorder gravacao; // Com --record, a entrada de cada iteracao.
+int joystickFd = -1;
+std::atomic<bool> rodando(true);
 
 
 int main(int argc, char** argv)
 {	
-	if(argc >= 2)
-		level = atoi(argv[1]);
-	else
+	int headlessTicks = 0;
+	unsigned int seed = 1;
+	int level = -1;
+	int threads = 0;
+	const char *gravar = NULL;
+	const char *reproduzir = NULL;
+	const char *carregar = NULL;
+	const char *salvar = NULL;
+	int porta = -1;
+	int taxa = 20;
+	int duracao = 0;
+	const char *servidor = NULL;
+	int fps = FRAME_ALVO;
+	const char *telemetria = NULL;
+	const char *monitor = NULL;
+
+	// Uso: ./jogoThaylo [inimigos] [--headless ITERACOES] [--seed SEMENTE] [--threads N] [--debug]
+	//                    [--profile] [--trace ARQUIVO.json] [--record ARQUIVO.inp]
+	//                    [--replay ARQUIVO.inp] [--load ARQUIVO.wld] [--save ARQUIVO.wld]
+	//                    [--server PORTA] [--rate SNAPSHOTS/S] [--connect HOST:PORTA] [--duration SEGUNDOS]
+	//                    [--fps QUADROS/S] [--telemetry NOME] [--monitor NOME]
+	for(int i = 1; i < argc; i++)
 	{
-		printf("Voce pode informar a quantidade de oponentes ao inicializar, por exemplo:\n\"./jogoThaylo 15\"");
-		level = 3;
+		if(strcmp(argv[i], "--headless") == 0 && i + 1 < argc)
+			headlessTicks = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+			seed = strtoul(argv[++i], NULL, 10);
+		else if(strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--debug") == 0)
+			setDebugSink(stderr, 20);
+		else if(strcmp(argv[i], "--profile") == 0)
+			profilerEnable(NULL);
+		else if(strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+			profilerEnable(argv[++i]);
+		else if(strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+			gravar = argv[++i];
+		else if(strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+			reproduzir = argv[++i];
+		else if(strcmp(argv[i], "--load") == 0 && i + 1 < argc)
+			carregar = argv[++i];
+		else if(strcmp(argv[i], "--save") == 0 && i + 1 < argc)
+			salvar = argv[++i];
+		else if(strcmp(argv[i], "--server") == 0 && i + 1 < argc)
+			porta = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--rate") == 0 && i + 1 < argc)
+			taxa = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--connect") == 0 && i + 1 < argc)
+			servidor = argv[++i];
+		else if(strcmp(argv[i], "--duration") == 0 && i + 1 < argc)
+			duracao = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+			fps = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc)
+			telemetria = argv[++i];
+		else if(strcmp(argv[i], "--monitor") == 0 && i + 1 < argc)
+			monitor = argv[++i];
+		else
+			level = atoi(argv[i]);
 	}
 
-	w = new window();
-	gameData = new GameData();
-
-	initGl();
-
-	long lastTime = getCurrentTime();
-
-
-	while(true)
+	// O monitor so le a telemetria de outro processo.
+	if(monitor != NULL)
+	{
+		return runMonitor(monitor, duracao);
+	}
+	if(telemetria != NULL && !telemetryEnable(telemetria))
 	{
+		printf("Nao foi possivel criar a telemetria %s\n", telemetria);
+	}
 
-		w->showWindow();
-		if(!w->processWindow(mouseFunc, keyPress, keyRelease))
+	// A gravacao diz com quantos inimigos e qual semente a partida foi jogada, e
+	// e refeita sem janela, sem esperar o relogio.
+	if(reproduzir != NULL)
+	{
+		InputReplay replay;
+		if(!replay.load(reproduzir))
 		{
-			break;
+			printf("Gravacao invalida: %s\n", reproduzir);
+			return 1;
 		}
+		int r = runHeadless(replay.getInimigos(), threads, (int) replay.getIteracoes(), replay.getSemente(), &replay);
+		profilerFinish();
+		telemetryFinish();
+		return r;
+	}
 
-		long currentTime = getCurrentTime();
-
-		if(currentTime - lastTime > TIME_STEP)
-		{
-			lastTime += TIME_STEP;
-			processLogic();
-		}		
-
-		gameData->drawGame();
+	// O cliente e um robo sem janela que so mede o servidor.
+	if(servidor != NULL)
+	{
+		return runClient(servidor, duracao > 0 ? duracao : 10, seed);
+	}
 
+	if(level < 0 && carregar == NULL)
+	{
+		printf("Voce pode informar a quantidade de oponentes ao inicializar, por exemplo:\n\"./jogoThaylo 15\"");
+		level = 3;
+	}
 
+	if(porta >= 0)
+	{
+		int r = runServer(porta, level, threads, seed, taxa, duracao);
+		profilerFinish();
+		telemetryFinish();
+		return r;
 	}
-	delete w;
-	delete gameData;
 
-	return 0;
-}
+	// --save grava o mundo depois das iteracoes sem janela (nenhuma, com --save sozinho).
+	if(headlessTicks > 0 || salvar != NULL)
+	{
+		int r = runHeadless(level, threads, headlessTicks, seed, NULL, carregar, salvar);
+		profilerFinish();
+		telemetryFinish();
+		return r;
+	}
 
-void processLogic()
-{
-	if(gameData->getControl()->keyEsc)
+	if(carregar != NULL)
 	{
-		exit(0);
+		gameData = GameData::load(carregar, threads);
+		if(gameData == NULL)
+		{
+			printf("Mundo invalido: %s\n", carregar);
+			return 1;
+		}
+		level = gameData->getQuant() - 1;
+	}
+	else
+	{
+		gameData = new GameData(level, threads, seed);
 	}
-	gameData->iterateGameData();
-}
 
-void mouseFunc(int type, int button, int x, int y)
-{
-	printf("mouse - type: %d, button: %d, x: %d, y: %d\n", type, button, x, y);
-}
+	long long inicioJanela = getMonotonicTime();
+	w = new window();
 
-void keyPress(int code)
-{
-	printf("key: %d, type: press\n", code);
-	Control *control = gameData->getControl();
+	// As texturas sao lidas em paralelo enquanto os primeiros quadros ja saem com
+	// substitutos no lugar.
+	AssetLoader *assets = new AssetLoader();
+	initGl(assets);
+	GameView *view = new GameView(assets);
+	assets->start(threads);
 
-	switch(code)
+	// A gravacao so guarda semente e inimigos: de um mundo carregado ela nao
+	// reproduziria a partida.
+	if(gravar != NULL && carregar != NULL)
+	{
+		printf("--record ignorado com --load\n");
+	}
+	else if(gravar != NULL && !gravacao.open(gravar, seed, level))
 	{
+		printf("Nao foi possivel gravar em %s\n", gravar);
+	}
+	joystickFd = open_joystick(); // Sem joystick fica -1 e so o X11 e ouvido.
 
-		case TURBINE_INC:
-		{
-			control->power_inc = true;
+	gameData->setSnapshotOutput(&snapshots);
+	std::thread simulacao(simulationLoop);
 
-		} break;
+	// O desenho interpola entre os dois ultimos estados do snapshot pelo tempo
+	// decorrido desde a sua publicacao.
+	const long long passo = TIME_STEP * 1000000LL;
+	long long intervaloQuadro = FRAME_STEP * 1000000LL;
 
-		case TURBINE_DEC:
-		{
-			control->power_dec = true;
+	// O governo so mexe no desenho: a simulacao continua na taxa cheia.
+	FrameGovernor governo(fps);
 
-		} break;
+	bool carregado = false;
+	long quadros = 0;
 
-		case ARROW_UP:
+	long long inicioAnterior = 0;
+	while(rodando)
+	{
+		long long inicioQuadro = getMonotonicTime();
+		if(inicioAnterior != 0) telemetryFrame(inicioQuadro - inicioAnterior, entrada.getQuant(), entrada.getDescartados());
+		inicioAnterior = inicioQuadro;
+
+		{
+			ProfileScope swap("swap", PROF_SWAP);
+			w->showWindow();
+		}
+		if(!processInput())
 		{
-			control->arrowUp = true;
-		} break;
+			break;
+		}
 
-		case ARROW_DOWN:
+		if(!carregado && (carregado = assets->uploadReady()))
 		{
-			control->arrowDown = true;
-		} break;
+			debugPrintf("texturas prontas em %.1f ms\n", (getMonotonicTime() - inicioJanela) / 1e6);
+		}
 
-		case ARROW_RIGHT:
+		const RenderSnapshot &s = snapshots.acquire();
+		double alpha = (double) (getMonotonicTime() - s.tempo) / passo;
+		if(alpha > 1) alpha = 1;
+		long long inicioDesenho = getMonotonicTime();
 		{
-			control->arrowRight = true;
-		} break;
+			ProfileScope desenho("desenho", PROF_DESENHO);
+			view->draw(s, alpha);
+		}
+		long long fimDesenho = getMonotonicTime();
+		if(governo.frame(fimDesenho - inicioQuadro, fimDesenho - inicioDesenho))
+		{
+			Qualidade q = governo.getQualidade();
+			view->setNivel(governo.getNivel());
+			w->setSwapInterval(q.swapInterval);
+			intervaloQuadro = q.ticksPorQuadro > 0 ? q.ticksPorQuadro * passo : FRAME_STEP * 1000000LL;
+			debugPrintf("qualidade: nivel %d\n", governo.getNivel());
+		}
 
-		case ARROW_LEFT:
+		if(quadros++ == 0)
 		{
-			control->arrowLeft = true;
-		} break;
-		case KEY_ESC:
+			debugPrintf("primeiro quadro em %.1f ms\n", (getMonotonicTime() - inicioJanela) / 1e6);
+		}
+
+		// Ate o proximo quadro so acorda quando chega entrada, que vai direto para a
+		// fila da simulacao em vez de esperar o quadro seguinte.
+		bool aberta = true;
+		long long espera;
+		while(aberta && rodando && (espera = inicioQuadro + intervaloQuadro - getMonotonicTime()) > 0)
 		{
-			control->keyEsc = true;
-			break;
+			waitInput(espera);
+			aberta = processInput();
 		}
-		case KEY_SPACE:
+		if(!aberta)
 		{
-			control->space = true;
 			break;
 		}
-	}	
-}
-
-void keyRelease(int code)
-{
-	printf("key: %d, type: release\n", code);
-	Control *control = gameData->getControl();
-
-	switch(code)
+	}
+	rodando = false;
+	simulacao.join();
+	if(joystickFd >= 0)
 	{
-		case TURBINE_INC:
-		{
-			control->power_inc = false;
+		close_joystick();
+	}
 
-		} break;
+	profilerFinish();
+	telemetryFinish();
 
-		case TURBINE_DEC:
-		{
-			control->power_dec = false;
+	delete assets; // Espera o carregador antes de apagar o que ele preenche.
+	delete view;
+	delete w;
+	gravacao.close();
+	delete gameData;
 
-		} break;
+	return 0;
+}
 
-		case ARROW_UP:
-		{
-			control->arrowUp = false;
-		} break;
+// Esvazia o X11 e o joystick na fila de entrada. Falso se a janela foi fechada.
+bool processInput()
+{
+	if(!w->processWindow(mouseFunc, keyPress, keyRelease))
+	{
+		return false;
+	}
 
-		case ARROW_DOWN:
-		{
-			control->arrowDown = false;
-		} break;
+	struct js_event jse;
+	while(joystickFd >= 0 && read_joystick_event(&jse) == 1)
+	{
+		enfileira(INPUT_JOYSTICK, jse.number, jse.value, jse.type);
+	}
+	return true;
+}
 
-		case ARROW_RIGHT:
-		{
-			control->arrowRight = false;
-		} break;
+// Dorme ate 'ns' nanossegundos, ou menos se o X11 ou o joystick tiverem algo.
+void waitInput(long long ns)
+{
+	if(w->hasQueuedEvents()) return;
+
+	struct pollfd fds[2];
+	int n = 0;
+	fds[n].fd = w->getConnectionFd();
+	fds[n].events = POLLIN;
+	n++;
+	if(joystickFd >= 0)
+	{
+		fds[n].fd = joystickFd;
+		fds[n].events = POLLIN;
+		n++;
+	}
+	poll(fds, n, (int) ((ns + 999999) / 1000000));
+}
 
-		case ARROW_LEFT:
-		{
-			control->arrowLeft = false;
-		} break;
+// Passo fixo: o tempo real decorrido vai para um acumulador, que e consumido em
+// passos de TIME_STEP (no maximo MAX_STEPS_PER_FRAME de uma vez).
+void simulationLoop()
+{
+	const long long passo = TIME_STEP * 1000000LL;
+	long long lastTime = getMonotonicTime();
+	long long acumulado = 0;
 
-		case KEY_ESC:
+	while(rodando)
+	{
+		long long currentTime = getMonotonicTime();
+		acumulado += currentTime - lastTime;
+		lastTime = currentTime;
+
+		int passos = 0;
+		while(acumulado >= passo && passos < MAX_STEPS_PER_FRAME && rodando)
 		{
-			control->keyEsc = false;
-			break;
+			processLogic();
+			acumulado -= passo;
+			passos++;
 		}
-		case KEY_SPACE:
+		if(acumulado >= passo)
 		{
-			control->space = false;
-			break;
+			// Atrasado demais para recuperar: descarta o excesso em vez de entrar em espiral.
+			acumulado %= passo;
 		}
-	}	
+
+		// Dorme ate o proximo passo.
+		usleep((passo - acumulado) / 1000);
+	}
+}
+
+void processLogic()
+{
+	Control *control = gameData->getControl();
+	entrada.drain(control);
+	if(control->keyEsc)
+	{
+		rodando = false;
+		return;
+	}
+	gravacao.record(control);
+	gameData->iterateGameData();
 }
 
+// Callbacks do X11: so enfileiram, quem aplica no Control e a simulacao.
+static void enfileira(unsigned char type, int code, int x, int y)
+{
+	InputEvent e;
+	e.type = type;
+	e.code = code;
+	e.x = x;
+	e.y = y;
+	entrada.push(e);
+}
 
+void mouseFunc(int type, int button, int x, int y)
+{
+	debugPrintf("mouse - type: %d, button: %d, x: %d, y: %d\n", type, button, x, y);
+	enfileira(type == ButtonPress ? INPUT_BUTTON_PRESS : INPUT_BUTTON_RELEASE, button, x, y);
+}
 
+void keyPress(int code)
+{
+	debugPrintf("key: %d, type: press\n", code);
+	enfileira(INPUT_KEY_PRESS, code, 0, 0);
+}
 
+void keyRelease(int code)
+{
+	debugPrintf("key: %d, type: release\n", code);
+	enfileira(INPUT_KEY_RELEASE, code, 0, 0);
+}
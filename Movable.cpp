@@ -9,148 +9,152 @@
 
 using namespace std;
 
-Movable::Movable(){
-	position = velocity = aceleration = 0;
-
-
-
-	roll = pitch = yaw = v_roll = v_pitch = v_yaw = 0;
-
-	dir = Vector(1,0,0);
-	side = Vector(0,1,0);
-	up = Vector(0,0,1);
-
+Movable::Movable(EntityStore *store_, const Vector &positionv, int type)
+{
+	store = store_;
+	slot = store->add(this, positionv, type);
 }
 
-Movable::Movable(const Vector &positionv)
+Vector Movable::getPosition() const
 {
-	position = positionv;
-	velocity = Vector(0,0,0);
-	aceleration = Vector(0,0,0);
-	roll= pitch= yaw = v_roll= v_pitch= v_yaw = 0;
-
-	dir = Vector(1,0,0);
-	side = Vector(0,1,0);
-	up = Vector(0,0,1);
+	return toVector(store->position[slot]);
 }
 
-Vector Movable::getPosition() const
+Vector Movable::getPrevPosition() const
 {
-	return position;
+	return toVector(store->prevPosition[slot]);
 }
 
 Vector Movable::getVelocity() const
 {
-	return velocity;
+	return toVector(store->velocity[slot]);
 }
 
 Vector Movable::getAceleration() const
 {
-	return aceleration;
+	return toVector(store->aceleration[slot]);
 }
 
+// Todos os corpos andam no plano: o "up" e sempre o eixo Z.
 Vector Movable::getUp() const
 {
-	return up;
+	return Vector(0,0,1);
 }
 
 Vector Movable::getDir() const
 {
-	return dir;
+	return toVector(store->dir[slot]);
 }
 
 Vector Movable::getSide() const
 {
-	return side;
+	Vec2f d = store->dir[slot];
+	return Vector(d.y, -d.x, 0);
 }
 
+// Os setters de posicao e orientacao teleportam: nao ha o que interpolar.
 void Movable::setPosition(const Vector &pos)
 {
-	position = pos;
+	store->position[slot] = store->prevPosition[slot] = toVec2f(pos);
 }
 
 void Movable::setVelocity(const Vector &vel)
 {
-	velocity = vel;
+	store->velocity[slot] = toVec2f(vel);
 }
 
 void Movable::setAcelerration(const Vector &acel)
 {
-	aceleration = acel;
+	store->aceleration[slot] = toVec2f(acel);
+}
+
+// dir e side sao derivados do rumo: fixar qualquer um deles fixa o rumo (e o outro).
+void Movable::setDir(const Vector &dirSet)
+{
+	store->setHeading(slot, atan2(-dirSet.getY(), -dirSet.getX()));
 }
 
-void Movable::setUp(const Vector &upSet)
+void Movable::setSide(const Vector &sideSet)
 {
-	up = upSet;
+	store->setHeading(slot, atan2(-sideSet.getX(), sideSet.getY()));
+}
+
+void Movable::setTeam(int team)
+{
+	store->team[slot] = team;
+}
+
+int Movable::getTeam() const
+{
+	return store->team[slot];
 }
 
 void Movable::setRoll(const double &rollRef)
 {
-	roll = rollRef;
+	store->cold[slot].roll = rollRef;
 }
 
 void Movable::setPitch(const double &pitchRef)
 {
-	pitch = pitchRef;
+	store->cold[slot].pitch = pitchRef;
 }
 
 void Movable::setYaw(const double &yawRef)
 {
-	yaw = yawRef;
+	store->setHeading(slot, yawRef);
 }
 
 double Movable::getRoll() const
 {
-	return roll;
+	return store->cold[slot].roll;
 }
 
 double Movable::getPitch() const
 {
-	return pitch;
+	return store->cold[slot].pitch;
 }
 
 double Movable::getYaw() const
 {
-	return yaw;
+	return store->yaw[slot];
 }
 
 void Movable::setVRoll(const double &vrollRef)
 {
-	v_roll = vrollRef;
+	store->setRolling(slot, vrollRef, store->cold[slot].v_pitch);
 }
 
 void Movable::setVPitch(const double &vpitchRef)
 {
-	v_pitch = vpitchRef;
+	store->setRolling(slot, store->cold[slot].v_roll, vpitchRef);
 }
 
 void Movable::setVYaw(const double &vyawRef)
 {
-	v_yaw = vyawRef;
+	store->v_yaw[slot] = vyawRef;
 }
 
-void Movable::iterate()
+double Movable::getMass() const
 {
+	return store->cold[slot].mass;
+}
 
-	if( velocity.getLengthVector() > MOVABLE_MAX_VELOCITY)
-	{
-		velocity.setVectorLength(MOVABLE_MAX_VELOCITY);
-	}
-
-
-	// Aqui começam os códigos de atualização das variáveis de estado.
-
-	roll += v_roll * TIME_STEP/500.0;
-	pitch += v_pitch * TIME_STEP/500.0;
-	yaw += v_yaw * TIME_STEP/500.0;
-
-
-	position = position + velocity*TIME_STEP/1000.0;
-	velocity = velocity + aceleration*TIME_STEP/1000.0 - velocity*MOVABLE_LINEAR_FRICTION*TIME_STEP/1000.0;
+double Movable::getCharge() const
+{
+	return store->cold[slot].charge;
+}
 
+void Movable::setMass(double mass_)
+{
+	store->cold[slot].mass = mass_;
+}
 
-	up = Vector(0,0,1);
-	side = side.rotateVector(up,v_yaw* TIME_STEP/1000.0).setVectorLength(1.0);
-	dir = up.crossProduct(side).setVectorLength(1.0);
+void Movable::setCharge(double charge_)
+{
+	store->cold[slot].charge = charge_;
+}
 
+Movable::~Movable()
+{
+	store->remove(slot);
 }
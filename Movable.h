@@ -10,31 +10,32 @@
 
 #include "Vector.h"
 #include "Constants.h"
+#include "EntityStore.h"
 namespace std {
 
+// Visao de um corpo guardado no EntityStore. O estado fica nas colunas do
+// store; a integracao de todos os corpos e feita em lote por EntityStore::integrate().
 class Movable {
-protected:
-	Vector position;
-	Vector velocity;
-	Vector aceleration;
+private:
+	EntityStore *store;
+	int slot;
 
-	Vector up;
-	Vector dir;
-	Vector side;
+	friend class ::EntityStore;
 
-	double roll, pitch, yaw; // http://www.toymaker.info/Games/assets/images/yawpitchroll.jpg
-	double v_roll, v_pitch, v_yaw;
+	Movable(const Movable &);
+	Movable &operator=(const Movable &);
 
 public:
 
-	Movable();
-	Movable(const Vector &positionv);
-
-	virtual void iterate();
-
+	Movable(EntityStore *store_, const Vector &positionv, int type);
 
+	EntityStore *getStore() const { return store; }
+	int getSlot() const { return slot; }
+	EntityHandle getHandle() const { return store->handleOf(slot); }
+	int getType() const { return store->type[slot]; }
 
 	Vector getPosition() const;
+	Vector getPrevPosition() const; // Posicao antes da ultima integracao.
 	Vector getVelocity() const;
 	Vector getAceleration() const;
 
@@ -46,7 +47,11 @@ public:
 	void setPosition(const Vector &pos);
 	void setVelocity(const Vector &vel);
 	void setAcelerration(const Vector &acel);
-	void setUp(const Vector &upSet);
+	void setDir(const Vector &dirSet);
+	void setSide(const Vector &sideSet);
+
+	void setTeam(int team);
+	int getTeam() const;
 
 
 	void setRoll(const double &rollRef);
@@ -61,7 +66,13 @@ public:
 	void setVPitch(const double &vpitchRef);
 	void setVYaw(const double &vyawRef);
 
-	virtual ~Movable(){};
+	// Materia do corpo (antiga classe Matter), na tabela fria do store.
+	double getMass() const;
+	double getCharge() const;
+	void setMass(double mass_);
+	void setCharge(double charge_);
+
+	virtual ~Movable();
 };
 
 } /* namespace std */
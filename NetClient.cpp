@@ -0,0 +1,173 @@
+/*
+ * NetClient.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "NetClient.h"
+#include "NetProtocol.h"
+#include "InputLog.h"
+#include "Constants.h"
+#include "Timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#define TROCA_ENTRADA 50 // Iteracoes ate o robo mudar de ideia.
+
+// O snapshot sendo montado: os fragmentos de um tick, em qualquer ordem.
+typedef struct Montagem {
+	unsigned int tick;
+	unsigned int base;
+	unsigned int jogador;
+	int fragmentos;
+	int recebidos;
+	int tamanho;
+	std::vector<unsigned char> bytes;
+	std::vector<unsigned char> chegou;
+} Montagem;
+
+static unsigned int botBits(unsigned int &semente)
+{
+	Control c = initializeControl();
+	c.arrowUp = rand_r(&semente) % 10 < 7;
+	int giro = rand_r(&semente) % 3;
+	c.arrowLeft = giro == 1;
+	c.arrowRight = giro == 2;
+	c.space = rand_r(&semente) % 10 < 3;
+	return packControl(&c);
+}
+
+int runClient(const char *hostPorta, int segundos, unsigned int seed)
+{
+	sockaddr_in servidor;
+	if(!netResolve(hostPorta, servidor))
+	{
+		printf("Servidor desconhecido: %s\n", hostPorta);
+		return 1;
+	}
+	int fd = netOpenSocket(0);
+	if(fd < 0)
+	{
+		printf("Nao foi possivel abrir um socket\n");
+		return 1;
+	}
+
+	NetSnapshot recebidos[NET_HISTORICO];
+	for(int i = 0; i < NET_HISTORICO; i++)
+	{
+		recebidos[i].tick = 0;
+	}
+	unsigned int ultimo = 0; // Tick do ultimo snapshot montado.
+	unsigned int jogador = 0;
+	Montagem m;
+	m.tick = 0;
+
+	long snapshots = 0, semBase = 0, invalidos = 0, completos = 0;
+	long long bytes = 0;
+	unsigned int bits = 0;
+	unsigned char pacote[NET_CABECALHO_SNAPSHOT + NET_FRAGMENTO];
+
+	const long long passo = TIME_STEP * 1000000LL;
+	long long inicio = getMonotonicTime();
+	long long fim = inicio + segundos * 1000000000LL;
+	long long proximo = inicio;
+	for(long t = 0; getMonotonicTime() < fim; t++)
+	{
+		if(t % TROCA_ENTRADA == 0) bits = botBits(seed);
+		unsigned char entrada[9];
+		entrada[0] = NET_ENTRADA;
+		netPutU32(entrada + 1, bits);
+		netPutU32(entrada + 5, ultimo);
+		sendto(fd, entrada, sizeof(entrada), 0, (const sockaddr *) &servidor, sizeof(servidor));
+
+		proximo += passo;
+		long long agora;
+		while((agora = getMonotonicTime()) < proximo)
+		{
+			struct pollfd p;
+			p.fd = fd;
+			p.events = POLLIN;
+			poll(&p, 1, (int) ((proximo - agora + 999999) / 1000000));
+
+			ssize_t n;
+			while((n = recv(fd, pacote, sizeof(pacote), 0)) >= NET_CABECALHO_SNAPSHOT)
+			{
+				bytes += n;
+				if(pacote[0] != NET_SNAPSHOT) continue;
+				int f = netGetU16(pacote + 1);
+				int total = netGetU16(pacote + 3);
+				unsigned int tick = netGetU32(pacote + 5);
+				if(tick <= ultimo || total == 0 || total > NET_MAX_FRAGMENTOS || f >= total) continue;
+				if(tick != m.tick)
+				{
+					if(tick < m.tick) continue; // Fragmento atrasado de um snapshot ja abandonado.
+					m.tick = tick;
+					m.base = netGetU32(pacote + 9);
+					m.jogador = netGetU32(pacote + 13);
+					m.fragmentos = total;
+					m.recebidos = 0;
+					m.tamanho = 0;
+					m.bytes.assign(total * NET_FRAGMENTO, 0);
+					m.chegou.assign(total, 0);
+				}
+				if(m.chegou[f]) continue;
+				m.chegou[f] = 1;
+				m.recebidos++;
+				int dados = (int) n - NET_CABECALHO_SNAPSHOT;
+				memcpy(&m.bytes[f * NET_FRAGMENTO], pacote + NET_CABECALHO_SNAPSHOT, dados);
+				if(f == total - 1) m.tamanho = f * NET_FRAGMENTO + dados;
+				if(m.recebidos < m.fragmentos) continue;
+
+				snapshots++;
+				const NetSnapshot *base = NULL;
+				if(m.base != 0)
+				{
+					base = &recebidos[m.base % NET_HISTORICO];
+					if(base->tick != m.base)
+					{
+						semBase++;
+						continue;
+					}
+				}
+				else completos++;
+				NetSnapshot &s = recebidos[m.tick % NET_HISTORICO];
+				if(!decodeSnapshot(base, &m.bytes[0], m.tamanho, s))
+				{
+					s.tick = 0;
+					invalidos++;
+					continue;
+				}
+				s.tick = m.tick;
+				ultimo = m.tick;
+				jogador = m.jogador;
+			}
+		}
+	}
+
+	unsigned char sair = NET_SAIR;
+	sendto(fd, &sair, 1, 0, (const sockaddr *) &servidor, sizeof(servidor));
+	close(fd);
+
+	double total = (getMonotonicTime() - inicio) / 1e9;
+	printf("cliente: %ld snapshots em %.1f s (%ld inteiros, %ld sem base, %ld invalidos), %.1f KB/s\n",
+			snapshots, total, completos, semBase, invalidos, bytes / 1024.0 / total);
+	if(ultimo != 0)
+	{
+		const NetSnapshot &s = recebidos[ultimo % NET_HISTORICO];
+		printf("  ultimo snapshot: tick %u, %d tanques, %d tiros", s.tick, (int) s.entidades.size(), (int) s.tiros.size());
+		for(unsigned int i = 0; i < s.entidades.size(); i++)
+		{
+			if(s.entidades[i].id + 1 == jogador)
+			{
+				printf(", meu tanque em (%.2f, %.2f)", netPosicao(s.entidades[i].x), netPosicao(s.entidades[i].y));
+			}
+		}
+		printf("\n");
+	}
+	return 0;
+}
@@ -0,0 +1,17 @@
+/*
+ * NetClient.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef NETCLIENT_H_
+#define NETCLIENT_H_
+
+// Cliente sem janela do modo servidor: um robo que dirige e atira ao acaso (pela
+// 'seed'), monta os snapshots recebidos a partir das bases e, depois de
+// 'segundos' segundos, imprime a banda recebida e o que viu do mundo. Serve para
+// medir o servidor com varios clientes de uma vez.
+int runClient(const char *hostPorta, int segundos, unsigned int seed);
+
+#endif /* NETCLIENT_H_ */
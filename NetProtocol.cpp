@@ -0,0 +1,304 @@
+/*
+ * NetProtocol.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "NetProtocol.h"
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+// Cada registro de tanque comeca com ((id - id anterior) << 3 | flags) + 1; um 0
+// fecha a lista. Os tanques que nao mudaram desde a base nao aparecem.
+#define REG_MUDOU 0    // dx, dy (e dyaw se REG_YAW), relativos a base.
+#define REG_NOVO 1     // Geracao, tipo, x, y e yaw inteiros.
+#define REG_REMOVIDO 2
+#define REG_TIPO 3
+#define REG_YAW 4
+
+int netQuantiza(double v)
+{
+	return (int) lrint(v * NET_QUANT_POS);
+}
+
+double netPosicao(int q)
+{
+	return q / NET_QUANT_POS;
+}
+
+unsigned short netQuantizaYaw(double yaw)
+{
+	return (unsigned short) lrint(yaw * (65536.0 / (2*M_PI)));
+}
+
+static void putVarint(std::vector<unsigned char> &out, unsigned int v)
+{
+	while(v >= 0x80)
+	{
+		out.push_back((unsigned char) (v | 0x80));
+		v >>= 7;
+	}
+	out.push_back((unsigned char) v);
+}
+
+// Zigzag: diferencas pequenas, positivas ou negativas, cabem em um byte.
+static void putSigned(std::vector<unsigned char> &out, int v)
+{
+	putVarint(out, ((unsigned int) v << 1) ^ (unsigned int) (v >> 31));
+}
+
+static void putEntity(std::vector<unsigned char> &out, const NetEntity &e)
+{
+	putVarint(out, e.generation);
+	out.push_back((unsigned char) (e.type | (e.jogador << 7)));
+	putSigned(out, e.x);
+	putSigned(out, e.y);
+	putVarint(out, e.yaw);
+}
+
+typedef struct Leitor {
+	const unsigned char *p;
+	const unsigned char *fim;
+	bool erro;
+} Leitor;
+
+static unsigned int getVarint(Leitor &l)
+{
+	unsigned int v = 0;
+	for(int shift = 0; shift < 35; shift += 7)
+	{
+		if(l.p >= l.fim)
+		{
+			l.erro = true;
+			return 0;
+		}
+		unsigned char b = *l.p++;
+		v |= (unsigned int) (b & 0x7f) << shift;
+		if(!(b & 0x80)) return v;
+	}
+	l.erro = true;
+	return 0;
+}
+
+static int getSigned(Leitor &l)
+{
+	unsigned int v = getVarint(l);
+	return (int) (v >> 1) ^ -(int) (v & 1);
+}
+
+static unsigned char getByte(Leitor &l)
+{
+	if(l.p >= l.fim)
+	{
+		l.erro = true;
+		return 0;
+	}
+	return *l.p++;
+}
+
+static void getEntity(Leitor &l, NetEntity &e)
+{
+	e.generation = getVarint(l);
+	unsigned char t = getByte(l);
+	e.type = t & 0x7f;
+	e.jogador = t >> 7;
+	e.x = getSigned(l);
+	e.y = getSigned(l);
+	e.yaw = (unsigned short) getVarint(l);
+}
+
+static void putRegistro(std::vector<unsigned char> &out, unsigned int &ultimoId, unsigned int id, unsigned int flags)
+{
+	putVarint(out, ((id - ultimoId) << 3 | flags) + 1);
+	ultimoId = id;
+}
+
+// Percorre base e atual juntos, os dois ordenados por id.
+void encodeSnapshot(const NetSnapshot *base, const NetSnapshot &atual, std::vector<unsigned char> &out)
+{
+	putVarint(out, atual.estadoJogo);
+
+	static const std::vector<NetEntity> vazio;
+	const std::vector<NetEntity> &b = base ? base->entidades : vazio;
+	const std::vector<NetEntity> &a = atual.entidades;
+	unsigned int i = 0, j = 0, ultimoId = 0;
+	while(i < b.size() || j < a.size())
+	{
+		if(j == a.size() || (i < b.size() && b[i].id < a[j].id))
+		{
+			putRegistro(out, ultimoId, b[i].id, REG_REMOVIDO);
+			i++;
+		}
+		else if(i == b.size() || a[j].id < b[i].id || a[j].generation != b[i].generation)
+		{
+			putRegistro(out, ultimoId, a[j].id, REG_NOVO);
+			putEntity(out, a[j]);
+			if(i < b.size() && b[i].id == a[j].id) i++;
+			j++;
+		}
+		else
+		{
+			const NetEntity &e = a[j], &anterior = b[i];
+			short dyaw = (short) (e.yaw - anterior.yaw);
+			if(e.x != anterior.x || e.y != anterior.y || dyaw != 0)
+			{
+				putRegistro(out, ultimoId, e.id, REG_MUDOU | (dyaw != 0 ? REG_YAW : 0));
+				putSigned(out, e.x - anterior.x);
+				putSigned(out, e.y - anterior.y);
+				if(dyaw != 0) putSigned(out, dyaw);
+			}
+			i++;
+			j++;
+		}
+	}
+	putVarint(out, 0);
+
+	putVarint(out, atual.tiros.size());
+	int x = 0, y = 0;
+	for(unsigned int k = 0; k < atual.tiros.size(); k++)
+	{
+		putSigned(out, atual.tiros[k].x - x);
+		putSigned(out, atual.tiros[k].y - y);
+		x = atual.tiros[k].x;
+		y = atual.tiros[k].y;
+	}
+}
+
+bool decodeSnapshot(const NetSnapshot *base, const unsigned char *dados, int n, NetSnapshot &out)
+{
+	Leitor l = { dados, dados + n, false };
+	out.estadoJogo = getVarint(l);
+	out.entidades.clear();
+	out.tiros.clear();
+
+	static const std::vector<NetEntity> vazio;
+	const std::vector<NetEntity> &b = base ? base->entidades : vazio;
+	unsigned int i = 0, id = 0;
+	unsigned int r;
+	while(!l.erro && (r = getVarint(l)) != 0)
+	{
+		r--;
+		id += r >> 3;
+		while(i < b.size() && b[i].id < id)
+		{
+			out.entidades.push_back(b[i++]);
+		}
+		bool naBase = i < b.size() && b[i].id == id;
+		switch(r & REG_TIPO)
+		{
+		case REG_NOVO:
+		{
+			NetEntity e;
+			e.id = id;
+			getEntity(l, e);
+			out.entidades.push_back(e);
+			if(naBase) i++;
+			break;
+		}
+		case REG_MUDOU:
+		{
+			if(!naBase) return false;
+			NetEntity e = b[i++];
+			e.x += getSigned(l);
+			e.y += getSigned(l);
+			if(r & REG_YAW) e.yaw += getSigned(l);
+			out.entidades.push_back(e);
+			break;
+		}
+		case REG_REMOVIDO:
+			if(!naBase) return false;
+			i++;
+			break;
+		default:
+			return false;
+		}
+	}
+	while(i < b.size())
+	{
+		out.entidades.push_back(b[i++]);
+	}
+
+	unsigned int quantTiros = getVarint(l);
+	if(l.erro || quantTiros > (unsigned int) (l.fim - l.p)) return false; // Ao menos um byte por tiro.
+	out.tiros.resize(quantTiros);
+	int x = 0, y = 0;
+	for(unsigned int k = 0; k < quantTiros; k++)
+	{
+		x += getSigned(l);
+		y += getSigned(l);
+		out.tiros[k].x = x;
+		out.tiros[k].y = y;
+	}
+	return !l.erro;
+}
+
+void netPutU16(unsigned char *p, unsigned int v)
+{
+	p[0] = v & 0xff;
+	p[1] = (v >> 8) & 0xff;
+}
+
+void netPutU32(unsigned char *p, unsigned int v)
+{
+	netPutU16(p, v & 0xffff);
+	netPutU16(p + 2, v >> 16);
+}
+
+unsigned int netGetU16(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+unsigned int netGetU32(const unsigned char *p)
+{
+	return netGetU16(p) | (netGetU16(p + 2) << 16);
+}
+
+int netOpenSocket(int porta)
+{
+	int fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if(fd < 0) return -1;
+
+	sockaddr_in a;
+	memset(&a, 0, sizeof(a));
+	a.sin_family = AF_INET;
+	a.sin_addr.s_addr = htonl(INADDR_ANY);
+	a.sin_port = htons(porta);
+	if(bind(fd, (sockaddr *) &a, sizeof(a)) != 0 || fcntl(fd, F_SETFL, O_NONBLOCK) != 0)
+	{
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+bool netResolve(const char *hostPorta, sockaddr_in &out)
+{
+	char host[256];
+	strncpy(host, hostPorta, sizeof(host) - 1);
+	host[sizeof(host) - 1] = 0;
+	int porta = NET_PORTA_PADRAO;
+	char *sep = strrchr(host, ':');
+	if(sep != NULL)
+	{
+		*sep = 0;
+		porta = atoi(sep + 1);
+	}
+
+	addrinfo dicas, *res;
+	memset(&dicas, 0, sizeof(dicas));
+	dicas.ai_family = AF_INET;
+	dicas.ai_socktype = SOCK_DGRAM;
+	if(getaddrinfo(host, NULL, &dicas, &res) != 0) return false;
+	out = *(sockaddr_in *) res->ai_addr;
+	out.sin_port = htons(porta);
+	freeaddrinfo(res);
+	return true;
+}
@@ -0,0 +1,79 @@
+/*
+ * NetProtocol.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef NETPROTOCOL_H_
+#define NETPROTOCOL_H_
+
+#include <vector>
+#include <netinet/in.h>
+
+// Protocolo do modo servidor, sobre UDP. O cliente manda, a cada iteracao, os
+// bits do seu Control (packControl) e o ultimo snapshot que recebeu inteiro; o
+// servidor roda o mundo e manda snapshots quantizados, codificados como diferenca
+// para esse ultimo recebido. Um snapshot maior que NET_FRAGMENTO vai em fragmentos.
+#define NET_PORTA_PADRAO 27960
+#define NET_FRAGMENTO 1200      // Bytes de snapshot por datagrama, abaixo do MTU comum.
+#define NET_MAX_FRAGMENTOS 4096
+#define NET_HISTORICO 32        // Snapshots guardados para servir de base.
+#define NET_MAX_CLIENTES 64
+#define NET_TIMEOUT 3000        // ms sem noticias ate o cliente ser descartado.
+#define NET_QUANT_POS 64.0      // Passos de posicao por unidade do mundo.
+
+// Primeiro byte de cada datagrama.
+#define NET_ENTRADA 1  // Cliente: bits do Control (u32) e ultimo tick recebido (u32).
+#define NET_SAIR 2     // Cliente: fim da conexao.
+#define NET_SNAPSHOT 3 // Servidor: cabecalho e um fragmento.
+
+// tipo, fragmento e total (u16), tick, base e o id do tanque do cliente (u32).
+#define NET_CABECALHO_SNAPSHOT 17
+
+// Um tanque como o cliente o ve. 'id' e o EntityHandle::index, estavel enquanto o
+// tanque existe; a geracao diz quando o indice foi reaproveitado.
+typedef struct NetEntity {
+	unsigned int id;
+	unsigned int generation;
+	int x, y;              // Posicao em 1/NET_QUANT_POS.
+	unsigned short yaw;    // Rumo em 2*pi/65536.
+	unsigned char type;
+	unsigned char jogador; // Do time do jogador.
+} NetEntity;
+
+typedef struct NetTiro {
+	int x, y;
+} NetTiro;
+
+// Os tiros nao tem id estavel (o ProjectileSystem troca com o ultimo ao remover),
+// entao vao inteiros em todo snapshot, cada um relativo ao anterior.
+typedef struct NetSnapshot {
+	unsigned int tick;     // 0 e nenhum.
+	int estadoJogo;
+	std::vector<NetEntity> entidades; // Ordenadas por id.
+	std::vector<NetTiro> tiros;
+} NetSnapshot;
+
+int netQuantiza(double v);
+double netPosicao(int q);
+unsigned short netQuantizaYaw(double yaw);
+
+// Acrescenta 'atual' em 'out' como diferenca para 'base' (NULL manda tudo).
+void encodeSnapshot(const NetSnapshot *base, const NetSnapshot &atual, std::vector<unsigned char> &out);
+// Refaz em 'out' o snapshot codificado em 'dados' a partir de 'base', que tem de
+// ser o mesmo usado por quem codificou. Falso se os dados estao corrompidos.
+bool decodeSnapshot(const NetSnapshot *base, const unsigned char *dados, int n, NetSnapshot &out);
+
+// Escrita e leitura em little endian, sem depender do layout das structs.
+void netPutU16(unsigned char *p, unsigned int v);
+void netPutU32(unsigned char *p, unsigned int v);
+unsigned int netGetU16(const unsigned char *p);
+unsigned int netGetU32(const unsigned char *p);
+
+// Socket UDP nao bloqueante; porta 0 deixa o sistema escolher. -1 se falhar.
+int netOpenSocket(int porta);
+// "host:porta" (ou so "host", na NET_PORTA_PADRAO). Falso se o host nao existe.
+bool netResolve(const char *hostPorta, sockaddr_in &out);
+
+#endif /* NETPROTOCOL_H_ */
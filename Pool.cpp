@@ -0,0 +1,103 @@
+/*
+ * Pool.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "Pool.h"
+#include <cstdlib>
+#include <new>
+
+#define POOL_ALIGN 16
+
+Pool::Pool(size_t blockSize_, int blocksPerChunk_)
+{
+	if(blockSize_ < sizeof(void *)) blockSize_ = sizeof(void *);
+	blockSize = (blockSize_ + POOL_ALIGN - 1) / POOL_ALIGN * POOL_ALIGN;
+	blocksPerChunk = blocksPerChunk_;
+	freeList = NULL;
+	capacity = live = peak = 0;
+	allocations = releases = systemAllocations = 0;
+}
+
+void Pool::grow(int nBlocks)
+{
+	char *chunk = (char *) malloc(blockSize * nBlocks);
+	if(chunk == NULL) throw std::bad_alloc();
+	systemAllocations++;
+	chunks.push_back(chunk);
+	chunkBlocks.push_back(nBlocks);
+
+	// Encadeia os blocos novos na frente da lista livre.
+	for(int i = nBlocks - 1; i >= 0; i--)
+	{
+		void *block = chunk + i*blockSize;
+		*(void **) block = freeList;
+		freeList = block;
+	}
+	capacity += nBlocks;
+}
+
+void Pool::reserve(int n)
+{
+	std::lock_guard<std::mutex> lock(m);
+	if(live + n > capacity)
+	{
+		grow(live + n - capacity);
+	}
+}
+
+void *Pool::allocate(size_t size)
+{
+	std::lock_guard<std::mutex> lock(m);
+	if(size > blockSize)
+	{
+		// Uma subclasse sem pool propria: atende, mas conta como malloc.
+		systemAllocations++;
+		allocations++;
+		return ::operator new(size);
+	}
+	if(freeList == NULL)
+	{
+		grow(blocksPerChunk);
+	}
+	void *block = freeList;
+	freeList = *(void **) block;
+
+	allocations++;
+	live++;
+	if(live > peak) peak = live;
+	return block;
+}
+
+void Pool::release(void *p)
+{
+	if(p == NULL) return;
+	std::lock_guard<std::mutex> lock(m);
+	releases++;
+
+	bool nosso = false;
+	for(unsigned int i = 0; i < chunks.size() && !nosso; i++)
+	{
+		char *c = (char *) chunks[i];
+		nosso = (char *) p >= c && (char *) p < c + blockSize * chunkBlocks[i];
+	}
+	if(!nosso)
+	{
+		::operator delete(p);
+		return;
+	}
+
+	*(void **) p = freeList;
+	freeList = p;
+	live--;
+}
+
+Pool::~Pool()
+{
+	for(unsigned int i = 0; i < chunks.size(); i++)
+	{
+		free(chunks[i]);
+	}
+}
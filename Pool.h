@@ -0,0 +1,57 @@
+/*
+ * Pool.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef POOL_H_
+#define POOL_H_
+
+#include <cstddef>
+#include <vector>
+#include <mutex>
+
+// Alocador de blocos de tamanho fixo. Os blocos liberados voltam para uma lista
+// livre e sao reaproveitados, entao depois de reservar a capacidade o jogo nao
+// chama mais malloc ao criar e destruir agentes. Protegido por um mutex: varios
+// GameData, em threads diferentes, usam os mesmos pools (criar e destruir
+// agentes e raro, a disputa nao pesa).
+class Pool {
+private:
+	size_t blockSize;
+	int blocksPerChunk;
+	void *freeList;
+	std::vector<void *> chunks;
+	std::vector<int> chunkBlocks;
+
+	int capacity;
+	int live;
+	int peak;
+	long allocations;
+	long releases;
+	long systemAllocations; // Chamadas a malloc (novos chunks e pedidos grandes demais).
+	mutable std::mutex m;
+
+	void grow(int nBlocks);
+
+public:
+	Pool(size_t blockSize_, int blocksPerChunk_ = 64);
+
+	// Garante espaco para mais n blocos, alem dos ja vivos, sem novas chamadas a malloc.
+	void reserve(int n);
+
+	void *allocate(size_t size);
+	void release(void *p);
+
+	int getCapacity() const { return capacity; }
+	int getLive() const { return live; }
+	int getPeak() const { return peak; }
+	long getAllocations() const { return allocations; }
+	long getReleases() const { return releases; }
+	long getSystemAllocations() const { return systemAllocations; }
+
+	~Pool();
+};
+
+#endif /* POOL_H_ */
@@ -0,0 +1,154 @@
+/*
+ * Profiler.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "Profiler.h"
+#include "Timer.h"
+#include <stdio.h>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+typedef struct TraceEvent {
+	const char *nome;
+	long long inicio;
+	long long duracao;
+} TraceEvent;
+
+// Eventos de uma thread. So ela escreve; profilerFinish() le depois que todas pararam.
+typedef struct TraceThread {
+	int tid;
+	std::vector<TraceEvent> eventos;
+} TraceThread;
+
+static bool ligado = false;
+static const char *arquivoTrace = NULL;
+static long long inicioTrace = 0;
+static std::atomic<long> eventosTrace(0);
+
+static std::mutex threadsMutex;
+static std::vector<TraceThread *> threadsTrace;
+static thread_local TraceThread *minhaThread = NULL;
+
+// Historicos: escritos pela thread da secao, lidos pelo overlay em outra.
+static std::atomic<long long> amostras[PROF_SECOES][PROF_HISTORICO];
+static std::atomic<int> proxima[PROF_SECOES];
+
+static const char *nomes[PROF_SECOES] = {
+	"tick", "ia", "integracao", "colisao", "desenho", "swap"
+};
+
+void profilerEnable(const char *trace)
+{
+	ligado = true;
+	arquivoTrace = trace;
+	inicioTrace = getMonotonicTime();
+}
+
+bool profilerEnabled()
+{
+	return ligado;
+}
+
+static void registraEvento(const char *nome, long long inicio, long long duracao)
+{
+	if(eventosTrace.fetch_add(1, std::memory_order_relaxed) >= PROF_MAX_EVENTOS) return;
+
+	if(minhaThread == NULL)
+	{
+		minhaThread = new TraceThread();
+		std::lock_guard<std::mutex> lock(threadsMutex);
+		minhaThread->tid = (int) threadsTrace.size();
+		threadsTrace.push_back(minhaThread);
+	}
+	TraceEvent e;
+	e.nome = nome;
+	e.inicio = inicio;
+	e.duracao = duracao;
+	minhaThread->eventos.push_back(e);
+}
+
+ProfileScope::ProfileScope(const char *nome_, int secao_)
+{
+	nome = nome_;
+	secao = secao_;
+	inicio = ligado ? getMonotonicTime() : 0;
+}
+
+ProfileScope::~ProfileScope()
+{
+	if(!ligado) return;
+
+	long long duracao = getMonotonicTime() - inicio;
+	if(secao >= 0)
+	{
+		int i = proxima[secao].load(std::memory_order_relaxed);
+		amostras[secao][i].store(duracao, std::memory_order_relaxed);
+		proxima[secao].store((i + 1) % PROF_HISTORICO, std::memory_order_relaxed);
+	}
+	if(arquivoTrace != NULL)
+	{
+		registraEvento(nome, inicio, duracao);
+	}
+}
+
+void profilerStats(int secao, double *media, double *maximo)
+{
+	long long soma = 0, max = 0;
+	int n = 0;
+	for(int i = 0; i < PROF_HISTORICO; i++)
+	{
+		long long a = amostras[secao][i].load(std::memory_order_relaxed);
+		if(a <= 0) continue; // Ainda nao medida.
+		soma += a;
+		if(a > max) max = a;
+		n++;
+	}
+	*media = n > 0 ? soma / (n * 1e6) : 0;
+	*maximo = max / 1e6;
+}
+
+const char *profilerSectionName(int secao)
+{
+	return nomes[secao];
+}
+
+void profilerFinish()
+{
+	if(arquivoTrace == NULL) return;
+
+	FILE *f = fopen(arquivoTrace, "w");
+	if(f == NULL)
+	{
+		printf("Nao foi possivel criar %s\n", arquivoTrace);
+		return;
+	}
+
+	// Eventos completos ("ph":"X"), com tempos em microssegundos.
+	fprintf(f, "{\"traceEvents\":[\n");
+	bool primeiro = true;
+	std::lock_guard<std::mutex> lock(threadsMutex);
+	for(unsigned int t = 0; t < threadsTrace.size(); t++)
+	{
+		const std::vector<TraceEvent> &ev = threadsTrace[t]->eventos;
+		for(unsigned int i = 0; i < ev.size(); i++)
+		{
+			fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+			        primeiro ? "" : ",\n", ev[i].nome, threadsTrace[t]->tid,
+			        (ev[i].inicio - inicioTrace) / 1000.0, ev[i].duracao / 1000.0);
+			primeiro = false;
+		}
+	}
+	fprintf(f, "\n]}\n");
+	fclose(f);
+
+	long total = eventosTrace.load();
+	if(total > PROF_MAX_EVENTOS)
+	{
+		printf("trace: %ld eventos descartados (limite %d)\n", total - PROF_MAX_EVENTOS, PROF_MAX_EVENTOS);
+	}
+	printf("trace gravado em %s\n", arquivoTrace);
+}
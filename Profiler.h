@@ -0,0 +1,56 @@
+/*
+ * Profiler.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+// Secoes medidas a cada iteracao ou quadro.
+#define PROF_TICK 0       // GameData::iterateGameData inteiro.
+#define PROF_IA 1         // Agent::iterate de todos os agentes.
+#define PROF_INTEGRACAO 2 // EntityStore::integrate e camera.
+#define PROF_COLISAO 3    // Colisoes dos tiros.
+#define PROF_DESENHO 4    // GameView::draw.
+#define PROF_SWAP 5       // glXSwapBuffers.
+#define PROF_SECOES 6
+
+// Amostras guardadas por secao (as ultimas PROF_HISTORICO iteracoes).
+#define PROF_HISTORICO 128
+
+// Limite de eventos no trace, para uma partida longa nao esgotar a memoria.
+#define PROF_MAX_EVENTOS 1000000
+
+// Medicao por escopo: o construtor marca o inicio e o destrutor guarda a duracao
+// no historico da secao (e no trace, se houver). Desligado custa um teste.
+// secao -1 so aparece no trace. Cada secao deve ser medida por uma thread so.
+class ProfileScope {
+private:
+	const char *nome;
+	int secao;
+	long long inicio;
+
+	ProfileScope(const ProfileScope &);
+	ProfileScope &operator=(const ProfileScope &);
+
+public:
+	ProfileScope(const char *nome_, int secao_ = -1);
+	~ProfileScope();
+};
+
+// Liga a medicao. Com 'trace' diferente de NULL os escopos tambem viram eventos
+// do formato Chrome trace (chrome://tracing, Perfetto), gravados por
+// profilerFinish(). Deve ser chamada antes de as threads comecarem.
+void profilerEnable(const char *trace);
+bool profilerEnabled();
+
+// Media e maximo, em milissegundos, das amostras guardadas de 'secao'.
+void profilerStats(int secao, double *media, double *maximo);
+const char *profilerSectionName(int secao);
+
+// Grava o trace, se pedido. Chamar com as outras threads ja paradas.
+void profilerFinish();
+
+#endif /* PROFILER_H_ */
@@ -0,0 +1,227 @@
+/*
+ * ProjectileSystem.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "ProjectileSystem.h"
+#include "EntityStore.h"
+#include <algorithm>
+
+ProjectileSystem::ProjectileSystem()
+{
+	peak = 0;
+	disparos = 0;
+	realocacoes = 0;
+	minX = minY = 0;
+	cellSize = COLLISION_GRID_CELL;
+	cellsX = cellsY = 0;
+}
+
+void ProjectileSystem::reserve(int n)
+{
+	position.reserve(n);
+	prevPosition.reserve(n);
+	velocity.reserve(n);
+	owner.reserve(n);
+	ttl.reserve(n);
+}
+
+void ProjectileSystem::spawn(const Vector &pos, const Vector &dir, int ownerId)
+{
+	if(position.size() == position.capacity()) realocacoes++;
+
+	Vec2f p = toVec2f(pos);
+	position.push_back(p);
+	prevPosition.push_back(p);
+	velocity.push_back(toVec2f(dir.normalized()*PROJETIL_VELOCIDADE));
+	owner.push_back(ownerId);
+	ttl.push_back(PROJETIL_VIDA);
+
+	disparos++;
+	if(size() > peak) peak = size();
+}
+
+void ProjectileSystem::integrate(int begin, int end)
+{
+	const float dt = TIME_STEP/1000.0f;
+	int n = end - begin;
+	if(n <= 0) return;
+
+	std::copy(position.begin() + begin, position.begin() + end, prevPosition.begin() + begin);
+	integratePositions(&position[begin], &velocity[begin], n, dt);
+	for(int i = begin; i < end; i++)
+	{
+		ttl[i]--;
+	}
+}
+
+int ProjectileSystem::cellX(double x) const
+{
+	int c = (int) floor((x - minX)/cellSize);
+	return c < 0 ? 0 : (c >= cellsX ? cellsX - 1 : c);
+}
+
+int ProjectileSystem::cellY(double y) const
+{
+	int c = (int) floor((y - minY)/cellSize);
+	return c < 0 ? 0 : (c >= cellsY ? cellsY - 1 : c);
+}
+
+void ProjectileSystem::collideOpposing()
+{
+	int n = size();
+	if(n < 2) return;
+
+	// Quase sempre todos os tiros sao do mesmo time.
+	bool misturados = false;
+	for(int i = 1; i < n && !misturados; i++)
+	{
+		misturados = owner[i] != owner[0];
+	}
+	if(!misturados) return;
+
+	double maxX, maxY;
+	minX = maxX = position[0].x;
+	minY = maxY = position[0].y;
+	for(int i = 1; i < n; i++)
+	{
+		minX = std::min(minX, (double) position[i].x);
+		maxX = std::max(maxX, (double) position[i].x);
+		minY = std::min(minY, (double) position[i].y);
+		maxY = std::max(maxY, (double) position[i].y);
+	}
+
+	// Mesmo limite de celulas do SpatialGrid. Dois tiros que se cruzaram no passo
+	// terminam a menos de HIT_RADIUS + 2*STEP um do outro, entao celulas desse
+	// tamanho bastam para so olhar as vizinhas.
+	long maxCells = 4L*n > 64 ? 4L*n : 64;
+	cellSize = PROJETIL_HIT_RADIUS + 2*PROJETIL_STEP;
+	do {
+		cellsX = (int)((maxX - minX)/cellSize) + 1;
+		cellsY = (int)((maxY - minY)/cellSize) + 1;
+		if((long) cellsX * cellsY <= maxCells) break;
+		cellSize *= 2;
+	} while(true);
+
+	int cells = cellsX*cellsY;
+	celula.resize(n);
+	inicioCelula.assign(cells + 1, 0);
+	for(int i = 0; i < n; i++)
+	{
+		celula[i] = cellY(position[i].y)*cellsX + cellX(position[i].x);
+		inicioCelula[celula[i] + 1]++;
+	}
+	for(int c = 0; c < cells; c++)
+	{
+		inicioCelula[c + 1] += inicioCelula[c];
+	}
+	ordem.resize(n);
+	cursor.assign(inicioCelula.begin(), inicioCelula.end() - 1);
+	for(int i = 0; i < n; i++)
+	{
+		ordem[cursor[celula[i]]++] = i;
+	}
+
+	// Cada par e visto uma vez (j > i) e os dois tiros morrem.
+	atingido.assign(n, 0);
+	double r2 = PROJETIL_HIT_RADIUS*PROJETIL_HIT_RADIUS;
+	for(int i = 0; i < n; i++)
+	{
+		int cx = celula[i] % cellsX, cy = celula[i] / cellsX;
+		for(int y = std::max(cy - 1, 0); y <= std::min(cy + 1, cellsY - 1); y++)
+		{
+			for(int x = std::max(cx - 1, 0); x <= std::min(cx + 1, cellsX - 1); x++)
+			{
+				int c = y*cellsX + x;
+				for(int k = inicioCelula[c]; k < inicioCelula[c + 1]; k++)
+				{
+					int j = ordem[k];
+					if(j <= i || owner[j] == owner[i]) continue;
+					if(segmentDistanceSquared(getPrevPosition(j) - getPrevPosition(i), getPosition(j) - getPosition(i)) < r2)
+					{
+						atingido[i] = atingido[j] = 1;
+					}
+				}
+			}
+		}
+	}
+	for(int i = 0; i < n; i++)
+	{
+		if(atingido[i]) ttl[i] = 0;
+	}
+}
+
+int ProjectileSystem::removeDead()
+{
+	int removidos = 0;
+	for(int i = 0; i < size(); )
+	{
+		if(ttl[i] > 0)
+		{
+			i++;
+			continue;
+		}
+		int ultimo = size() - 1;
+		position[i] = position[ultimo];
+		prevPosition[i] = prevPosition[ultimo];
+		velocity[i] = velocity[ultimo];
+		owner[i] = owner[ultimo];
+		ttl[i] = ttl[ultimo];
+		position.pop_back();
+		prevPosition.pop_back();
+		velocity.pop_back();
+		owner.pop_back();
+		ttl.pop_back();
+		removidos++;
+	}
+	return removidos;
+}
+
+void ProjectileSystem::writeSnapshot(std::vector<SnapshotEntity> &out) const
+{
+	Vector up(0,0,1);
+	int base = (int) out.size();
+	out.resize(base + size());
+	for(int i = 0; i < size(); i++)
+	{
+		SnapshotEntity &e = out[base + i];
+		Vector dir = toVector(velocity[i]).normalized();
+		Vector side = dir.crossProduct(up);
+		snapshotStore(e.prevPosition, getPrevPosition(i));
+		snapshotStore(e.position, getPosition(i));
+		snapshotStore(e.prevDir, dir);
+		snapshotStore(e.dir, dir);
+		snapshotStore(e.prevSide, side);
+		snapshotStore(e.side, side);
+		e.type = ENTITY_PROJETIL;
+	}
+}
+
+void ProjectileSystem::getColunas(Coluna *out)
+{
+	unsigned int n = size();
+	Coluna c[WORLD_COLUNAS_TIROS] = {
+		{ position.data(), sizeof(Vec2f), n },
+		{ prevPosition.data(), sizeof(Vec2f), n },
+		{ velocity.data(), sizeof(Vec2f), n },
+		{ owner.data(), sizeof(int), n },
+		{ ttl.data(), sizeof(int), n },
+	};
+	for(int i = 0; i < WORLD_COLUNAS_TIROS; i++)
+	{
+		out[i] = c[i];
+	}
+}
+
+void ProjectileSystem::restore(int n, long disparos_, int peak_)
+{
+	position.resize(n);
+	prevPosition.resize(n);
+	velocity.resize(n);
+	owner.resize(n);
+	ttl.resize(n);
+	disparos = disparos_;
+	peak = peak_ > n ? peak_ : n;
+}
@@ -0,0 +1,89 @@
+/*
+ * ProjectileSystem.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef PROJECTILESYSTEM_H_
+#define PROJECTILESYSTEM_H_
+
+#include <vector>
+#include "Vector.h"
+#include "Constants.h"
+#include "RenderSnapshot.h"
+#include "WorldFile.h"
+
+#define PROJETIL_VELOCIDADE MOVABLE_MAX_VELOCITY
+// Iteracoes ate o tiro percorrer PROJETIL_RANGE.
+#define PROJETIL_VIDA ((int) (PROJETIL_RANGE / (PROJETIL_VELOCIDADE*TIME_STEP/1000.0)) + 1)
+// O quanto um tiro anda em um passo.
+#define PROJETIL_STEP (PROJETIL_VELOCIDADE*TIME_STEP/1000.0)
+
+// Todos os tiros em voo, em colunas contiguas. Um tiro nao e um Agent: anda em
+// linha reta com velocidade constante ate a vida acabar ou ele ser atingido, e so
+// tem posicao, velocidade, dono e vida. Andam no plano, como os tanques: as
+// posicoes e a velocidade sao Vec2f. As colisoes com tanques ficam com o
+// GameData; tiro contra tiro de donos diferentes e resolvido aqui.
+class ProjectileSystem {
+private:
+	std::vector<Vec2f> position;
+	std::vector<Vec2f> prevPosition;
+	std::vector<Vec2f> velocity;
+	std::vector<int> owner; // Time de quem atirou (Agent::getId()).
+	std::vector<int> ttl;   // Iteracoes restantes; 0 e morto.
+
+	int peak;
+	long disparos;
+	long realocacoes;
+
+	// Grade dos proprios tiros para o teste tiro contra tiro (counting sort).
+	double minX, minY, cellSize;
+	int cellsX, cellsY;
+	std::vector<int> celula;
+	std::vector<int> inicioCelula;
+	std::vector<int> ordem;
+	std::vector<int> cursor;
+	std::vector<unsigned char> atingido;
+
+	int cellX(double x) const;
+	int cellY(double y) const;
+
+public:
+	ProjectileSystem();
+
+	void reserve(int n);
+	int size() const { return (int) position.size(); }
+
+	void spawn(const Vector &pos, const Vector &dir, int ownerId);
+
+	// Move os tiros [begin, end) e gasta uma iteracao de vida de cada um.
+	void integrate(int begin, int end);
+
+	// Mata os pares de tiros de donos diferentes que passaram a menos de
+	// PROJETIL_HIT_RADIUS um do outro durante o ultimo passo.
+	void collideOpposing();
+
+	void kill(int i) { ttl[i] = 0; }
+	// Tira os mortos (troca com o ultimo) e devolve quantos saíram.
+	int removeDead();
+
+	Vector getPosition(int i) const { return toVector(position[i]); }
+	Vector getPrevPosition(int i) const { return toVector(prevPosition[i]); }
+	int getOwner(int i) const { return owner[i]; }
+
+	// Acrescenta os tiros em 'out' como ENTITY_PROJETIL.
+	void writeSnapshot(std::vector<SnapshotEntity> &out) const;
+
+	// As WORLD_COLUNAS_TIROS colunas, para gravar e restaurar o mundo.
+	void getColunas(Coluna *out);
+	// Ao restaurar: 'n' tiros (preenchidos depois por getColunas) e os contadores.
+	void restore(int n, long disparos_, int peak_);
+
+	int getPeak() const { return peak; }
+	int getCapacity() const { return (int) position.capacity(); }
+	long getDisparos() const { return disparos; }
+	long getRealocacoes() const { return realocacoes; }
+};
+
+#endif /* PROJECTILESYSTEM_H_ */
@@ -0,0 +1,56 @@
+/*
+ * PursuitField.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "PursuitField.h"
+#include <math.h>
+
+// Diagonal da celula: o quanto o centro pode estar longe de quem pergunta.
+#define CAMPO_FOLGA (CAMPO_CELULA * 1.4142135623730951)
+
+PursuitField::PursuitField()
+{
+	alvo = NULL;
+	minX = minY = 0;
+	celulas.resize(CAMPO_LADO * CAMPO_LADO);
+}
+
+// O campo fica preso a grade do mundo (nao ao alvo), entao o centro de cada
+// celula so muda quando o alvo passa para outra celula.
+void PursuitField::build(const void *alvo_, const Vector &posicao)
+{
+	alvo = alvo_;
+	minX = (floor(posicao.getX() / CAMPO_CELULA) - CAMPO_LADO/2) * CAMPO_CELULA;
+	minY = (floor(posicao.getY() / CAMPO_CELULA) - CAMPO_LADO/2) * CAMPO_CELULA;
+	for(int y = 0; y < CAMPO_LADO; y++)
+	{
+		double dy = posicao.getY() - (minY + (y + 0.5) * CAMPO_CELULA);
+		for(int x = 0; x < CAMPO_LADO; x++)
+		{
+			double dx = posicao.getX() - (minX + (x + 0.5) * CAMPO_CELULA);
+			double d = sqrt(dx*dx + dy*dy);
+			Celula &c = celulas[y*CAMPO_LADO + x];
+			c.dist = (float) d;
+			c.dirX = (float) (d > 0 ? dx/d : 0);
+			c.dirY = (float) (d > 0 ? dy/d : 0);
+			c.reservado = 0;
+		}
+	}
+}
+
+bool PursuitField::sample(const Vector &pos, Vector &direcao, double &distancia) const
+{
+	double fx = (pos.getX() - minX) * (1.0/CAMPO_CELULA);
+	double fy = (pos.getY() - minY) * (1.0/CAMPO_CELULA);
+	if(fx < 0 || fy < 0 || fx >= CAMPO_LADO || fy >= CAMPO_LADO) return false;
+	int x = (int) fx, y = (int) fy;
+
+	const Celula &c = celulas[y*CAMPO_LADO + x];
+	if(c.dist < AI_DIST_PERTO + CAMPO_FOLGA) return false;
+	direcao = Vector(c.dirX, c.dirY, 0);
+	distancia = c.dist;
+	return true;
+}
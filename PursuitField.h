@@ -0,0 +1,44 @@
+/*
+ * PursuitField.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef PURSUITFIELD_H_
+#define PURSUITFIELD_H_
+
+#include <vector>
+#include "Vector.h"
+#include "Constants.h"
+
+#define CAMPO_CELULA 4.0 // Lado da celula (unidades do mundo).
+#define CAMPO_LADO 32    // Celulas por lado; o campo cobre +-64 em volta do alvo.
+
+// Campo de perseguicao de um alvo: para cada celula de uma grade grossa em volta
+// dele, a direcao (unitaria) e a distancia do centro da celula ate o alvo.
+// Montado uma vez por iteracao para cada alvo que os inimigos seguem, e lido por
+// todos eles sem custo de raiz ou de atan2. Hoje e so a linha reta; quando o
+// Terrain tiver obstaculos e aqui que entra o caminho em volta deles.
+class PursuitField {
+private:
+	const void *alvo; // Quem o campo segue nesta iteracao (so para comparar).
+	double minX, minY;
+	typedef struct Celula {
+		float dirX, dirY, dist, reservado; // Uma leitura por amostra.
+	} Celula;
+	std::vector<Celula> celulas;
+
+public:
+	PursuitField();
+
+	void build(const void *alvo_, const Vector &posicao);
+	const void *getAlvo() const { return alvo; }
+
+	// Direcao e distancia ate o alvo vistas de 'pos'. Falso fora do campo e perto
+	// do alvo (menos de AI_DIST_PERTO, com a folga de uma celula), onde o erro do
+	// centro da celula pesaria: ali quem pergunta faz a conta exata.
+	bool sample(const Vector &pos, Vector &direcao, double &distancia) const;
+};
+
+#endif /* PURSUITFIELD_H_ */
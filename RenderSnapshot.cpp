@@ -0,0 +1,71 @@
+/*
+ * RenderSnapshot.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "RenderSnapshot.h"
+
+void snapshotStore(float *dst, const Vector &v)
+{
+	dst[0] = v.getX();
+	dst[1] = v.getY();
+	dst[2] = v.getZ();
+}
+
+Vector snapshotVector(const float *v)
+{
+	return Vector(v[0], v[1], v[2]);
+}
+
+Vector snapshotLerp(const float *anterior, const float *atual, double a)
+{
+	return Vector(anterior[0]*(1 - a) + atual[0]*a,
+	              anterior[1]*(1 - a) + atual[1]*a,
+	              anterior[2]*(1 - a) + atual[2]*a);
+}
+
+Vector snapshotLerpDir(const float *anterior, const float *atual, double a)
+{
+	Vector r = snapshotLerp(anterior, atual, a);
+	if(r.getLengthVector() < 1e-6) return snapshotVector(atual);
+	return r.setVectorLength(1.0);
+}
+
+SnapshotBuffer::SnapshotBuffer()
+{
+	escrita = 0;
+	pronto = 1;
+	leitura = 2;
+	novo = false;
+	for(int i = 0; i < 3; i++)
+	{
+		buffers[i].tempo = 0;
+		buffers[i].estadoJogo = 0;
+		buffers[i].jogador = -1;
+		buffers[i].alvoRadar = -1;
+	}
+}
+
+void SnapshotBuffer::publish()
+{
+	std::lock_guard<std::mutex> lock(m);
+	int aux = pronto;
+	pronto = escrita;
+	escrita = aux;
+	novo = true;
+}
+
+const RenderSnapshot &SnapshotBuffer::acquire()
+{
+	std::lock_guard<std::mutex> lock(m);
+	if(novo)
+	{
+		int aux = leitura;
+		leitura = pronto;
+		pronto = aux;
+		novo = false;
+	}
+	return buffers[leitura];
+}
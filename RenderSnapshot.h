@@ -0,0 +1,84 @@
+/*
+ * RenderSnapshot.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef RENDERSNAPSHOT_H_
+#define RENDERSNAPSHOT_H_
+
+#include <vector>
+#include <mutex>
+#include "Vector.h"
+
+// O que o desenho precisa de um corpo: o estado desta iteracao e o da anterior,
+// para interpolar entre os dois.
+typedef struct SnapshotEntity {
+	float prevPosition[3];
+	float position[3];
+	float prevDir[3];
+	float dir[3];
+	float prevSide[3];
+	float side[3];
+	unsigned char type;
+} SnapshotEntity;
+
+// Tanques de uma celula da grade da simulacao e a caixa que eles ocupam (nas
+// duas posicoes, atual e anterior), para o desenho descartar a celula inteira.
+typedef struct SnapshotCell {
+	float min[3];
+	float max[3];
+	int inicio;           // Em RenderSnapshot::ordemCelulas.
+	int quant;
+} SnapshotCell;
+
+// Copia imutavel do mundo publicada pela simulacao no fim de cada iteracao. O
+// desenho so le isto, nunca os Agents, entao pode rodar em outra thread.
+typedef struct RenderSnapshot {
+	long long tempo;      // getMonotonicTime() da publicacao.
+	int estadoJogo;
+	int jogador;          // Indice do jogador em 'entidades' (-1 antes da primeira publicacao).
+	int alvoRadar;        // Indice do alvo do radar do jogador, -1 se nao ha.
+	float prevOlho[3];    // Camera.
+	float olho[3];
+	float up[3];
+	std::vector<SnapshotEntity> entidades;
+	std::vector<SnapshotCell> celulas;  // So as celulas com tanques; tiros nao entram.
+	std::vector<int> ordemCelulas;      // Indices em 'entidades', agrupados por celula.
+} RenderSnapshot;
+
+void snapshotStore(float *dst, const Vector &v);
+Vector snapshotVector(const float *v);
+Vector snapshotLerp(const float *anterior, const float *atual, double a);
+// Interpola direcoes e renormaliza (o giro por passo e pequeno).
+Vector snapshotLerpDir(const float *anterior, const float *atual, double a);
+
+// Buffer triplo: a simulacao escreve em um, o desenho le outro, e o terceiro
+// guarda o ultimo publicado. Nenhum lado espera o outro alem de uma troca de
+// indices, entao um glXSwapBuffers preso no vsync nao atrasa a iteracao.
+class SnapshotBuffer {
+private:
+	RenderSnapshot buffers[3];
+	int escrita;
+	int pronto;
+	int leitura;
+	bool novo;
+	std::mutex m;
+
+	SnapshotBuffer(const SnapshotBuffer &);
+	SnapshotBuffer &operator=(const SnapshotBuffer &);
+
+public:
+	SnapshotBuffer();
+
+	// Lado da simulacao: preenche getEscrita() e chama publish().
+	RenderSnapshot &getEscrita() { return buffers[escrita]; }
+	void publish();
+
+	// Lado do desenho: o snapshot publicado mais recente. Fica intacto ate o
+	// proximo acquire().
+	const RenderSnapshot &acquire();
+};
+
+#endif /* RENDERSNAPSHOT_H_ */
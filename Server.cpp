@@ -0,0 +1,326 @@
+/*
+ * Server.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "Server.h"
+#include "InputLog.h"
+#include "Timer.h"
+#include <algorithm>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#define RAIO_ENTRADA 10.0 // Os clientes entram em volta da origem.
+#define RELATORIO 5       // Segundos entre relatorios.
+
+static bool porId(const NetEntity &a, const NetEntity &b)
+{
+	return a.id < b.id;
+}
+
+GameServer::GameServer(GameData *mundo_, int fd_, int taxa_) : interesse(NET_CELULA_INTERESSE)
+{
+	mundo = mundo_;
+	fd = fd_;
+	taxa = taxa_ > 0 && taxa_ < 1000/TIME_STEP ? taxa_ : 1000/TIME_STEP;
+	credito = 0;
+	for(int i = 0; i < NET_MAX_CLIENTES; i++)
+	{
+		clientes[i].ativo = false;
+	}
+	quantClientes = 0;
+	atual.tick = 0;
+	tempoMundo = tempoSnapshot = tempoEnvio = 0;
+	bytesEnviados = 0;
+	iteracoes = 0;
+	descartados = descartadosRelatorio = 0;
+}
+
+GameServer::Cliente *GameServer::find(const sockaddr_in &endereco)
+{
+	for(int i = 0; i < NET_MAX_CLIENTES; i++)
+	{
+		Cliente &c = clientes[i];
+		if(c.ativo && c.endereco.sin_addr.s_addr == endereco.sin_addr.s_addr && c.endereco.sin_port == endereco.sin_port)
+		{
+			return &c;
+		}
+	}
+	return NULL;
+}
+
+GameServer::Cliente *GameServer::join(const sockaddr_in &endereco)
+{
+	for(int i = 0; i < NET_MAX_CLIENTES; i++)
+	{
+		Cliente &c = clientes[i];
+		if(c.ativo) continue;
+
+		c.ativo = true;
+		c.endereco = endereco;
+		c.control = initializeControl();
+		c.ack = 0;
+		for(int k = 0; k < NET_HISTORICO; k++)
+		{
+			c.historico[k].tick = 0;
+		}
+		double angulo = i * (2*M_PI / NET_MAX_CLIENTES);
+		c.centro = Vector(RAIO_ENTRADA*cos(angulo), RAIO_ENTRADA*sin(angulo), 0);
+		Agent *a = mundo->addPlayer(&c.control, c.centro);
+		c.tanque = a->getHandle();
+		quantClientes++;
+		return &c;
+	}
+	return NULL; // Cheio: o pacote e ignorado.
+}
+
+// O tanque sai no fim da proxima iteracao, como qualquer destruido.
+void GameServer::drop(Cliente &c)
+{
+	Agent *a = mundo->getAgent(c.tanque);
+	if(a != NULL) a->destroyNow();
+	c.ativo = false;
+	quantClientes--;
+}
+
+void GameServer::receive()
+{
+	unsigned char buf[64];
+	sockaddr_in de;
+	socklen_t tam = sizeof(de);
+	ssize_t n;
+	while((n = recvfrom(fd, buf, sizeof(buf), 0, (sockaddr *) &de, &tam)) > 0)
+	{
+		Cliente *c = find(de);
+		if(buf[0] == NET_ENTRADA && n >= 9)
+		{
+			if(c == NULL && (c = join(de)) == NULL) continue;
+			unpackControl(netGetU32(buf + 1), &c->control);
+			unsigned int ack = netGetU32(buf + 5);
+			if(ack > c->ack) c->ack = ack; // Datagramas podem chegar fora de ordem.
+			c->ultimoPacote = getMonotonicTime();
+		}
+		else if(buf[0] == NET_SAIR && c != NULL)
+		{
+			drop(*c);
+		}
+		tam = sizeof(de);
+	}
+}
+
+// Tanques ordenados pelo indice do handle, que nao muda enquanto eles existem. Na
+// mesma passada eles entram na grade de interesse.
+void GameServer::buildSnapshot()
+{
+	atual.tick = (unsigned int) mundo->getIteracao();
+	atual.estadoJogo = mundo->getEstadoJogo();
+	atual.entidades.clear();
+	interesse.clear();
+	unsigned int maiorId = 0;
+	for(int i = 0; i < mundo->getQuant(); i++)
+	{
+		Agent *a = mundo->getAgent(i);
+		if(a->isToDestroy()) continue; // O jogador local fica no store depois de destruido.
+
+		EntityHandle h = a->getHandle();
+		Vector p = a->getPosition();
+		NetEntity e;
+		e.id = h.index;
+		e.generation = h.generation;
+		e.x = netQuantiza(p.getX());
+		e.y = netQuantiza(p.getY());
+		e.yaw = netQuantizaYaw(a->getYaw());
+		e.type = a->getType();
+		e.jogador = a->getId() == PLAYER_ID;
+		atual.entidades.push_back(e);
+		interesse.insert(a);
+		if(e.id > maiorId) maiorId = e.id;
+	}
+	interesse.build();
+	std::sort(atual.entidades.begin(), atual.entidades.end(), porId);
+	indiceDe.assign(maiorId + 1, -1);
+	for(unsigned int k = 0; k < atual.entidades.size(); k++)
+	{
+		indiceDe[atual.entidades[k].id] = k;
+	}
+
+	const ProjectileSystem *tiros = mundo->getTiros();
+	atual.tiros.resize(tiros->size());
+	for(int i = 0; i < tiros->size(); i++)
+	{
+		atual.tiros[i].x = netQuantiza(tiros->getPosition(i).getX());
+		atual.tiros[i].y = netQuantiza(tiros->getPosition(i).getY());
+	}
+}
+
+// Os tanques saem da grade; os tiros, que nao estao nela, sao testados um a um
+// (so comparacoes de inteiros).
+void GameServer::buildRecorte(Cliente &c, NetSnapshot &recorte)
+{
+	Agent *tanque = mundo->getAgent(c.tanque);
+	if(tanque != NULL && !tanque->isToDestroy()) c.centro = tanque->getPosition();
+
+	recorte.tick = atual.tick;
+	recorte.estadoJogo = atual.estadoJogo;
+	recorte.entidades.clear();
+	vizinhos.clear();
+	interesse.query(c.centro, NET_RAIO_INTERESSE, vizinhos);
+	for(unsigned int k = 0; k < vizinhos.size(); k++)
+	{
+		recorte.entidades.push_back(atual.entidades[indiceDe[vizinhos[k]->getHandle().index]]);
+	}
+	std::sort(recorte.entidades.begin(), recorte.entidades.end(), porId);
+
+	recorte.tiros.clear();
+	int cx = netQuantiza(c.centro.getX()), cy = netQuantiza(c.centro.getY());
+	long long raio = netQuantiza(NET_RAIO_INTERESSE);
+	for(unsigned int k = 0; k < atual.tiros.size(); k++)
+	{
+		long long dx = atual.tiros[k].x - cx, dy = atual.tiros[k].y - cy;
+		if(dx*dx + dy*dy < raio*raio) recorte.tiros.push_back(atual.tiros[k]);
+	}
+}
+
+void GameServer::send(Cliente &c)
+{
+	NetSnapshot &recorte = c.historico[atual.tick % NET_HISTORICO];
+	buildRecorte(c, recorte);
+
+	// A base tem de ser uma que o cliente ainda guarda e que ainda esta no historico.
+	unsigned int base = c.ack;
+	if(base == 0 || atual.tick - base >= NET_HISTORICO || c.historico[base % NET_HISTORICO].tick != base) base = 0;
+
+	bytes.clear();
+	encodeSnapshot(base ? &c.historico[base % NET_HISTORICO] : NULL, recorte, bytes);
+	int fragmentos = ((int) bytes.size() + NET_FRAGMENTO - 1) / NET_FRAGMENTO;
+	if(fragmentos == 0) fragmentos = 1;
+	if(fragmentos > NET_MAX_FRAGMENTOS)
+	{
+		// O cliente fica sem atualizacao nesta vez; o relatorio conta quantas.
+		if(descartados++ == 0)
+		{
+			printf("servidor: snapshot de %d bytes passa de %d fragmentos e nao foi mandado\n",
+					(int) bytes.size(), NET_MAX_FRAGMENTOS);
+		}
+		descartadosRelatorio++;
+		return;
+	}
+
+	Agent *tanque = mundo->getAgent(c.tanque);
+	pacote[0] = NET_SNAPSHOT;
+	netPutU16(pacote + 3, fragmentos);
+	netPutU32(pacote + 5, atual.tick);
+	netPutU32(pacote + 9, base);
+	netPutU32(pacote + 13, tanque ? tanque->getHandle().index + 1 : 0);
+	for(int f = 0; f < fragmentos; f++)
+	{
+		int inicio = f * NET_FRAGMENTO;
+		int n = std::min((int) bytes.size() - inicio, NET_FRAGMENTO);
+		netPutU16(pacote + 1, f);
+		if(n > 0) memcpy(pacote + NET_CABECALHO_SNAPSHOT, &bytes[inicio], n);
+		sendto(fd, pacote, NET_CABECALHO_SNAPSHOT + n, 0, (const sockaddr *) &c.endereco, sizeof(c.endereco));
+		bytesEnviados += NET_CABECALHO_SNAPSHOT + n;
+	}
+}
+
+void GameServer::step()
+{
+	long long t0 = getMonotonicTime();
+	for(int i = 0; i < NET_MAX_CLIENTES; i++)
+	{
+		if(clientes[i].ativo && t0 - clientes[i].ultimoPacote > NET_TIMEOUT * 1000000LL) drop(clientes[i]);
+	}
+	mundo->iterateGameData();
+	long long t1 = getMonotonicTime();
+	tempoMundo += t1 - t0;
+	iteracoes++;
+
+	// Snapshots espacados o mais igual possivel, 'taxa' por segundo exatos mesmo
+	// quando ela nao divide a de iteracoes.
+	credito += taxa;
+	if(credito < 1000/TIME_STEP) return;
+	credito -= 1000/TIME_STEP;
+	if(quantClientes == 0) return;
+
+	buildSnapshot();
+	long long t2 = getMonotonicTime();
+	tempoSnapshot += t2 - t1;
+
+	for(int i = 0; i < NET_MAX_CLIENTES; i++)
+	{
+		if(clientes[i].ativo) send(clientes[i]);
+	}
+	tempoEnvio += getMonotonicTime() - t2;
+}
+
+void GameServer::report(double segundos)
+{
+	int n = iteracoes > 0 ? iteracoes : 1;
+	printf("servidor: %d clientes, %d entidades, iteracao %.1f us, snapshot %.1f us",
+			quantClientes, mundo->getQuantEntidades(), tempoMundo / 1e3 / n, tempoSnapshot / 1e3 / n);
+	if(quantClientes > 0)
+	{
+		printf(", envio %.1f us e %.1f KB/s por cliente", tempoEnvio / 1e3 / n / quantClientes,
+				bytesEnviados / 1024.0 / segundos / quantClientes);
+	}
+	if(descartadosRelatorio > 0)
+	{
+		printf(", %ld snapshots grandes demais descartados (%ld no total)", descartadosRelatorio, descartados);
+	}
+	printf("\n");
+	descartadosRelatorio = 0;
+	tempoMundo = tempoSnapshot = tempoEnvio = 0;
+	bytesEnviados = 0;
+	iteracoes = 0;
+}
+
+int runServer(int porta, int inimigos, int threads, unsigned int seed, int taxa, int segundos)
+{
+	int fd = netOpenSocket(porta);
+	if(fd < 0)
+	{
+		printf("Nao foi possivel abrir a porta %d\n", porta);
+		return 1;
+	}
+
+	GameData *mundo = new GameData(inimigos, threads, seed, true);
+	mundo->setSilencioso(true);
+	GameServer servidor(mundo, fd, taxa);
+	printf("servidor na porta %d: %d inimigos, semente %u, %d snapshots/s\n", porta, inimigos, seed, servidor.getTaxa());
+
+	// Passo fixo em tempo real; entre um passo e outro so acorda para ler o socket.
+	const long long passo = TIME_STEP * 1000000LL;
+	long long agora = getMonotonicTime();
+	long long proximo = agora;
+	long long fim = segundos > 0 ? agora + segundos * 1000000000LL : 0;
+	long long relatorio = agora + RELATORIO * 1000000000LL;
+	while(fim == 0 || agora < fim)
+	{
+		while((agora = getMonotonicTime()) < proximo)
+		{
+			struct pollfd p;
+			p.fd = fd;
+			p.events = POLLIN;
+			poll(&p, 1, (int) ((proximo - agora + 999999) / 1000000));
+			servidor.receive();
+		}
+		servidor.receive();
+		servidor.step();
+
+		proximo += passo;
+		if(agora - proximo > MAX_STEPS_PER_FRAME * passo) proximo = agora; // Atrasado demais: descarta.
+		if(agora >= relatorio)
+		{
+			servidor.report(RELATORIO);
+			relatorio += RELATORIO * 1000000000LL;
+		}
+	}
+
+	close(fd);
+	delete mundo;
+	return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Server.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef SERVER_H_
+#define SERVER_H_
+
+#include "GameData.h"
+#include "NetProtocol.h"
+
+// Raio de interesse: cada cliente so recebe o que esta a esta distancia do seu
+// tanque, o alcance do tiro. A banda por cliente depende da densidade em volta
+// dele, nao do tamanho do mundo.
+#define NET_RAIO_INTERESSE PROJETIL_RANGE
+#define NET_CELULA_INTERESSE (NET_RAIO_INTERESSE/4)
+
+// Servidor autoritativo: o mundo so roda aqui. Cada cliente e um tanque do time do
+// jogador guiado pelo Control que ele manda. O snapshot quantizado do mundo inteiro
+// e a grade de interesse sao montados uma vez por iteracao; cada cliente recebe o
+// recorte em volta do seu tanque, como diferenca para o seu ultimo recorte confirmado.
+class GameServer {
+private:
+	typedef struct Cliente {
+		bool ativo;
+		sockaddr_in endereco;
+		Control control;
+		EntityHandle tanque;
+		Vector centro;          // Onde o tanque esta, ou onde estava quando foi destruido.
+		unsigned int ack;       // Ultimo tick que o cliente recebeu inteiro (0: nenhum).
+		long long ultimoPacote; // getMonotonicTime().
+		NetSnapshot historico[NET_HISTORICO]; // Os recortes mandados a ele, bases possiveis.
+	} Cliente;
+
+	GameData *mundo;
+	int fd;
+	int taxa;      // Snapshots por segundo, no maximo um por iteracao.
+	int credito;   // Acumulador: cada iteracao soma 'taxa'; um snapshot custa 1000/TIME_STEP.
+	Cliente clientes[NET_MAX_CLIENTES];
+	int quantClientes;
+	NetSnapshot atual;       // O mundo inteiro nesta iteracao.
+	std::vector<int> indiceDe; // Por id, a posicao em atual.entidades (-1: fora).
+	SpatialGrid interesse;
+	std::vector<Agent *> vizinhos;
+	std::vector<unsigned char> bytes;
+	unsigned char pacote[NET_CABECALHO_SNAPSHOT + NET_FRAGMENTO];
+
+	// Medidas desde o ultimo relatorio.
+	long long tempoMundo, tempoSnapshot, tempoEnvio;
+	long long bytesEnviados;
+	int iteracoes;
+	long descartadosRelatorio;
+	long descartados; // Snapshots que passaram de NET_MAX_FRAGMENTOS, desde o inicio.
+
+	GameServer(const GameServer &);
+	GameServer &operator=(const GameServer &);
+
+	Cliente *find(const sockaddr_in &endereco);
+	Cliente *join(const sockaddr_in &endereco);
+	void drop(Cliente &c);
+	void buildSnapshot();
+	// Em 'recorte', so o que esta no raio de interesse de 'c'.
+	void buildRecorte(Cliente &c, NetSnapshot &recorte);
+	void send(Cliente &c);
+
+public:
+	// 'taxa' snapshots por segundo, no maximo um por iteracao.
+	GameServer(GameData *mundo_, int fd_, int taxa_);
+
+	// Esvazia o socket: entradas, entradas de clientes novos e saidas.
+	void receive();
+	// Uma iteracao do mundo e, se for a vez, o snapshot para todos.
+	void step();
+	// Imprime o custo por iteracao e por cliente desde a ultima chamada.
+	void report(double segundos);
+	int getClientes() const { return quantClientes; }
+	int getTaxa() const { return taxa; }
+};
+
+// Roda um mundo de 'inimigos' inimigos (o jogador local e um cacador da IA) em
+// tempo real na 'porta', por 'segundos' segundos (0: sem fim).
+int runServer(int porta, int inimigos, int threads, unsigned int seed, int taxa, int segundos);
+
+#endif /* SERVER_H_ */
@@ -0,0 +1,194 @@
+/*
+ * SpatialGrid.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "SpatialGrid.h"
+#include "Agent.h"
+
+SpatialGrid::SpatialGrid()
+{
+	baseCellSize = cellSize = SPATIAL_GRID_CELL;
+	minX = minY = 0;
+	cellsX = cellsY = 0;
+}
+
+SpatialGrid::SpatialGrid(double cellSize_)
+{
+	baseCellSize = cellSize = cellSize_;
+	minX = minY = 0;
+	cellsX = cellsY = 0;
+}
+
+int SpatialGrid::cellCoord(double v, double min) const
+{
+	return (int) floor((v - min)/cellSize);
+}
+
+int SpatialGrid::cellOf(const Vector &pos) const
+{
+	int cx = cellCoord(pos.getX(), minX);
+	int cy = cellCoord(pos.getY(), minY);
+	if(cx < 0) cx = 0;
+	if(cy < 0) cy = 0;
+	if(cx >= cellsX) cx = cellsX - 1;
+	if(cy >= cellsY) cy = cellsY - 1;
+	return cy*cellsX + cx;
+}
+
+void SpatialGrid::clear()
+{
+	pending.clear();
+}
+
+void SpatialGrid::insert(Agent *a)
+{
+	Entry e;
+	e.agent = a;
+	e.position = a->getPosition();
+	pending.push_back(e);
+}
+
+void SpatialGrid::build()
+{
+	int n = (int) pending.size();
+	entries.resize(n);
+	cellsX = cellsY = 0;
+	if(n == 0) return;
+
+	double maxX, maxY;
+	minX = maxX = pending[0].position.getX();
+	minY = maxY = pending[0].position.getY();
+	for(int i = 1; i < n; i++)
+	{
+		double x = pending[i].position.getX();
+		double y = pending[i].position.getY();
+		if(x < minX) minX = x;
+		if(x > maxX) maxX = x;
+		if(y < minY) minY = y;
+		if(y > maxY) maxY = y;
+	}
+
+	// Um agente perdido longe dos outros nao pode explodir a quantidade de celulas.
+	long maxCells = 4L*n > 64 ? 4L*n : 64;
+	cellSize = baseCellSize;
+	do {
+		cellsX = (int)((maxX - minX)/cellSize) + 1;
+		cellsY = (int)((maxY - minY)/cellSize) + 1;
+		if((long) cellsX * cellsY <= maxCells) break;
+		cellSize *= 2;
+	} while(true);
+
+	int cells = cellsX * cellsY;
+	cellStart.assign(cells + 1, 0);
+	entryCell.resize(n);
+	for(int i = 0; i < n; i++)
+	{
+		int cx = cellCoord(pending[i].position.getX(), minX);
+		int cy = cellCoord(pending[i].position.getY(), minY);
+		if(cx >= cellsX) cx = cellsX - 1;
+		if(cy >= cellsY) cy = cellsY - 1;
+		entryCell[i] = cy*cellsX + cx;
+		cellStart[entryCell[i] + 1]++;
+	}
+	for(int c = 0; c < cells; c++)
+	{
+		cellStart[c + 1] += cellStart[c];
+	}
+
+	// Counting sort: cellStart[c] serve de cursor durante a insercao e e restaurado depois.
+	for(int i = 0; i < n; i++)
+	{
+		entries[cellStart[entryCell[i]]++] = pending[i];
+	}
+	for(int c = cells; c > 0; c--)
+	{
+		cellStart[c] = cellStart[c - 1];
+	}
+	cellStart[0] = 0;
+}
+
+Agent *SpatialGrid::nearest(const Vector &pos, double maxDist, const Agent *self, int ignoreId) const
+{
+	if(cellsX == 0) return NULL;
+
+	int cx = cellCoord(pos.getX(), minX);
+	int cy = cellCoord(pos.getY(), minY);
+
+	int maxRing = abs(cx);
+	if(abs(cx - (cellsX - 1)) > maxRing) maxRing = abs(cx - (cellsX - 1));
+	if(abs(cy) > maxRing) maxRing = abs(cy);
+	if(abs(cy - (cellsY - 1)) > maxRing) maxRing = abs(cy - (cellsY - 1));
+
+	Agent *best = NULL;
+	double bestDist2 = maxDist*maxDist;
+
+	for(int r = 0; r <= maxRing; r++)
+	{
+		// Tudo que falta visitar esta a pelo menos (r-1) celulas de distancia.
+		double ringDist = (r - 1)*cellSize;
+		if(ringDist > 0 && ringDist*ringDist >= bestDist2) break;
+
+		for(int y = cy - r; y <= cy + r; y++)
+		{
+			if(y < 0 || y >= cellsY) continue;
+			bool borda = (y == cy - r || y == cy + r);
+			int step = (borda || r == 0) ? 1 : 2*r;
+			for(int x = cx - r; x <= cx + r; x += step)
+			{
+				if(x < 0 || x >= cellsX) continue;
+				int c = y*cellsX + x;
+				for(int k = cellStart[c]; k < cellStart[c + 1]; k++)
+				{
+					const Entry &e = entries[k];
+					if(e.agent == self || e.agent->getId() == ignoreId || e.agent->isToDestroy()) continue;
+					Vector d = e.position - pos;
+					double dist2 = d.dotProduct(d);
+					if(dist2 < bestDist2)
+					{
+						bestDist2 = dist2;
+						best = e.agent;
+					}
+				}
+			}
+		}
+	}
+	return best;
+}
+
+void SpatialGrid::query(const Vector &pos, double radius, std::vector<Agent *> &out) const
+{
+	if(cellsX == 0) return;
+
+	int x0 = cellCoord(pos.getX() - radius, minX);
+	int x1 = cellCoord(pos.getX() + radius, minX);
+	int y0 = cellCoord(pos.getY() - radius, minY);
+	int y1 = cellCoord(pos.getY() + radius, minY);
+	if(x0 < 0) x0 = 0;
+	if(y0 < 0) y0 = 0;
+	if(x1 >= cellsX) x1 = cellsX - 1;
+	if(y1 >= cellsY) y1 = cellsY - 1;
+
+	double radius2 = radius*radius;
+	for(int y = y0; y <= y1; y++)
+	{
+		for(int x = x0; x <= x1; x++)
+		{
+			int c = y*cellsX + x;
+			for(int k = cellStart[c]; k < cellStart[c + 1]; k++)
+			{
+				Vector d = entries[k].position - pos;
+				if(d.dotProduct(d) < radius2)
+				{
+					out.push_back(entries[k].agent);
+				}
+			}
+		}
+	}
+}
+
+SpatialGrid::~SpatialGrid()
+{
+}
@@ -0,0 +1,65 @@
+/*
+ * SpatialGrid.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef SPATIALGRID_H_
+#define SPATIALGRID_H_
+
+#include <vector>
+#include "Vector.h"
+#include "Constants.h"
+
+namespace std {
+class Agent;
+}
+
+// Grade uniforme no plano XY, reconstruida uma vez por iteracao do jogo.
+// As celulas cobrem apenas a caixa envolvente dos agentes inseridos, e os
+// agentes ficam ordenados por celula (counting sort) num unico vetor.
+class SpatialGrid {
+private:
+	struct Entry {
+		Agent *agent;
+		Vector position;
+	};
+
+	double cellSize;
+	double baseCellSize;
+	double minX, minY;
+	int cellsX, cellsY;
+
+	std::vector<Entry> pending;
+	std::vector<Entry> entries;
+	std::vector<int> cellStart;
+	std::vector<int> entryCell;
+
+	int cellCoord(double v, double min) const;
+
+public:
+	SpatialGrid();
+	SpatialGrid(double cellSize_);
+
+	void clear();
+	void insert(Agent *a);
+	void build();
+
+	int getQuant() const { return (int) entries.size(); }
+	int getCellCount() const { return cellsX * cellsY; }
+
+	// Celula que contem pos, presa a borda da grade. A grade nao pode estar vazia.
+	int cellOf(const Vector &pos) const;
+
+	// Agente mais proximo de pos (ate maxDist), ignorando 'self', os agentes com id 'ignoreId'
+	// e os ja marcados para destruicao.
+	Agent *nearest(const Vector &pos, double maxDist, const Agent *self, int ignoreId) const;
+
+	// Acrescenta em 'out' todos os agentes a menos de 'radius' de pos.
+	void query(const Vector &pos, double radius, std::vector<Agent *> &out) const;
+
+	~SpatialGrid();
+};
+
+#endif /* SPATIALGRID_H_ */
@@ -0,0 +1,220 @@
+/*
+ * Telemetry.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "Telemetry.h"
+#include "Timer.h"
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/mman.h>
+
+static TelemetriaSegmento *segmento = NULL;
+static std::string nomeSegmento;
+
+// So o escritor do campo grava nele, entao ler, somar e gravar nao perde nada.
+static inline void grava(unsigned long long *campo, unsigned long long valor)
+{
+	__atomic_store_n(campo, valor, __ATOMIC_RELAXED);
+}
+
+static inline unsigned long long le(const unsigned long long *campo)
+{
+	return __atomic_load_n(campo, __ATOMIC_RELAXED);
+}
+
+static int balde(long long ns)
+{
+	unsigned long long us = ns > 0 ? ns / 1000 : 0;
+	int k = 0;
+	while(us > 1 && k < TELEMETRIA_BALDES - 1)
+	{
+		us >>= 1;
+		k++;
+	}
+	return k;
+}
+
+static void registra(TelemetriaHistograma *h, long long ns)
+{
+	if(ns < 0) ns = 0;
+	grava(&h->quant, h->quant + 1);
+	grava(&h->soma, h->soma + ns);
+	grava(&h->ultimo, ns);
+	if((unsigned long long) ns > h->maximo) grava(&h->maximo, ns);
+	unsigned long long *b = &h->baldes[balde(ns)];
+	grava(b, *b + 1);
+}
+
+// Nomes do shm_open comecam com '/'.
+static std::string nomeCompleto(const char *nome)
+{
+	return nome[0] == '/' ? std::string(nome) : "/" + std::string(nome);
+}
+
+bool telemetryEnable(const char *nome)
+{
+	nomeSegmento = nomeCompleto(nome);
+	int fd = shm_open(nomeSegmento.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+	if(fd < 0) return false;
+	if(ftruncate(fd, sizeof(TelemetriaSegmento)) != 0)
+	{
+		close(fd);
+		shm_unlink(nomeSegmento.c_str());
+		return false;
+	}
+	void *p = mmap(NULL, sizeof(TelemetriaSegmento), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if(p == MAP_FAILED)
+	{
+		shm_unlink(nomeSegmento.c_str());
+		return false;
+	}
+
+	// O ftruncate ja zerou tudo; o magic por ultimo diz a quem le que o resto vale.
+	segmento = (TelemetriaSegmento *) p;
+	segmento->versao = TELEMETRIA_VERSAO;
+	segmento->tamanho = sizeof(TelemetriaSegmento);
+	segmento->pid = getpid();
+	segmento->inicio = getMonotonicTime();
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	memcpy(segmento->magic, TELEMETRIA_MAGIC, 4);
+	return true;
+}
+
+bool telemetryEnabled()
+{
+	return segmento != NULL;
+}
+
+void telemetryTick(long long duracao, int tanques, int projeteis, int disparos, int destruicoes)
+{
+	TelemetriaSegmento *s = segmento;
+	if(s == NULL) return;
+	registra(&s->tick, duracao);
+	grava(&s->tanques, tanques);
+	grava(&s->projeteis, projeteis);
+	grava(&s->disparos, s->disparos + disparos);
+	grava(&s->destruicoes, s->destruicoes + destruicoes);
+	grava(&s->atualizado, getMonotonicTime());
+	grava(&s->iteracoes, s->iteracoes + 1);
+}
+
+void telemetryFrame(long long duracao, unsigned int fila, long descartadas)
+{
+	TelemetriaSegmento *s = segmento;
+	if(s == NULL) return;
+	registra(&s->quadro, duracao);
+	grava(&s->filaEntrada, fila);
+	if(fila > s->filaEntradaMax) grava(&s->filaEntradaMax, fila);
+	grava(&s->entradasDescartadas, descartadas);
+	grava(&s->quadros, s->quadros + 1);
+}
+
+void telemetryFinish()
+{
+	if(segmento == NULL) return;
+	munmap(segmento, sizeof(TelemetriaSegmento));
+	shm_unlink(nomeSegmento.c_str());
+	segmento = NULL;
+}
+
+// Limite superior, em us, do balde onde a fracao 'p' das amostras novas ja foi contada.
+static long long percentilBaldes(const TelemetriaHistograma &agora, const TelemetriaHistograma &antes, double p)
+{
+	unsigned long long total = agora.quant - antes.quant, soma = 0;
+	if(total == 0) return 0;
+	for(int k = 0; k < TELEMETRIA_BALDES; k++)
+	{
+		soma += agora.baldes[k] - antes.baldes[k];
+		if(soma >= p * total) return 2LL << k;
+	}
+	return 2LL << (TELEMETRIA_BALDES - 1);
+}
+
+static void copia(TelemetriaHistograma &dst, const TelemetriaHistograma &src)
+{
+	dst.quant = le(&src.quant);
+	dst.soma = le(&src.soma);
+	dst.ultimo = le(&src.ultimo);
+	dst.maximo = le(&src.maximo);
+	for(int k = 0; k < TELEMETRIA_BALDES; k++)
+	{
+		dst.baldes[k] = le(&src.baldes[k]);
+	}
+}
+
+static void leSegmento(const TelemetriaSegmento *s, TelemetriaSegmento &out)
+{
+	out.iteracoes = le(&s->iteracoes);
+	out.tanques = le(&s->tanques);
+	out.projeteis = le(&s->projeteis);
+	out.disparos = le(&s->disparos);
+	out.destruicoes = le(&s->destruicoes);
+	copia(out.tick, s->tick);
+	out.quadros = le(&s->quadros);
+	out.filaEntrada = le(&s->filaEntrada);
+	out.filaEntradaMax = le(&s->filaEntradaMax);
+	out.entradasDescartadas = le(&s->entradasDescartadas);
+	copia(out.quadro, s->quadro);
+}
+
+int runMonitor(const char *nome, int segundos)
+{
+	std::string completo = nomeCompleto(nome);
+	int fd = shm_open(completo.c_str(), O_RDONLY, 0);
+	if(fd < 0)
+	{
+		printf("Nenhuma telemetria em %s\n", completo.c_str());
+		return 1;
+	}
+	void *p = mmap(NULL, sizeof(TelemetriaSegmento), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	const TelemetriaSegmento *s = (const TelemetriaSegmento *) p;
+	if(p == MAP_FAILED || memcmp(s->magic, TELEMETRIA_MAGIC, 4) != 0 ||
+	   s->versao != TELEMETRIA_VERSAO || s->tamanho != sizeof(TelemetriaSegmento))
+	{
+		printf("%s nao e uma telemetria desta versao\n", completo.c_str());
+		if(p != MAP_FAILED) munmap(p, sizeof(TelemetriaSegmento));
+		return 1;
+	}
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+	TelemetriaSegmento antes, agora;
+	leSegmento(s, antes);
+	long long t0 = getMonotonicTime(), anterior = t0;
+	for(int i = 1; segundos == 0 || i <= segundos; i++)
+	{
+		sleep(1);
+		if(kill(s->pid, 0) != 0) break; // O jogo saiu.
+
+		leSegmento(s, agora);
+		long long t = getMonotonicTime();
+		double dt = (t - anterior) / 1e9;
+		anterior = t;
+
+		unsigned long long ticks = agora.tick.quant - antes.tick.quant;
+		unsigned long long quadros = agora.quadro.quant - antes.quadro.quant;
+		printf("%5.0f s: %.1f it/s, tick %.1f us (p99 < %lld us), %llu tanques, %llu tiros, %.1f disparos/s, %.1f destruicoes/s",
+				(t - t0) / 1e9, ticks / dt, ticks ? (agora.tick.soma - antes.tick.soma) / 1e3 / ticks : 0.0,
+				percentilBaldes(agora.tick, antes.tick, 0.99), agora.tanques, agora.projeteis,
+				(agora.disparos - antes.disparos) / dt, (agora.destruicoes - antes.destruicoes) / dt);
+		if(agora.quadros > 0)
+		{
+			printf(", %.1f quadros/s, quadro %.2f ms, fila %llu (max %llu)", quadros / dt,
+					quadros ? (agora.quadro.soma - antes.quadro.soma) / 1e6 / quadros : 0.0,
+					agora.filaEntrada, agora.filaEntradaMax);
+		}
+		printf("\n");
+		fflush(stdout);
+		antes = agora;
+	}
+	munmap(p, sizeof(TelemetriaSegmento));
+	return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Telemetry.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+// Metricas ao vivo num segmento de memoria compartilhada (shm_open), para um
+// agente de fora ler sem parar o jogo: ele so mapeia /dev/shm/NOME e le. Cada
+// campo tem um escritor so e e gravado com um store atomico relaxado de 64 bits,
+// entao nao ha trava e o jogo nunca espera quem le; quem le ve cada campo
+// inteiro, mas campos diferentes podem ser de iteracoes vizinhas. Contadores so
+// crescem: as taxas saem da diferenca entre duas leituras.
+#define TELEMETRIA_MAGIC "TLM1"
+#define TELEMETRIA_VERSAO 1
+#define TELEMETRIA_NOME "/jogoThaylo"
+
+// Balde k conta as amostras de [2^k, 2^(k+1)) microssegundos (o 0 tambem as
+// abaixo de 1 us; o ultimo tudo acima).
+#define TELEMETRIA_BALDES 24
+
+typedef struct TelemetriaHistograma {
+	unsigned long long quant;
+	unsigned long long soma;   // ns.
+	unsigned long long ultimo; // ns.
+	unsigned long long maximo; // ns.
+	unsigned long long baldes[TELEMETRIA_BALDES];
+} TelemetriaHistograma;
+
+// O layout do segmento. A parte da simulacao e a do desenho ficam em linhas de
+// cache separadas, cada uma escrita por uma thread so.
+typedef struct TelemetriaSegmento {
+	char magic[4];
+	unsigned int versao;
+	unsigned int tamanho;    // sizeof(TelemetriaSegmento) de quem escreve.
+	int pid;
+	unsigned long long inicio; // getMonotonicTime() ao abrir.
+
+	// Simulacao: uma vez por iteracao, no fim de GameData::iterateGameData().
+	alignas(64) unsigned long long iteracoes;
+	unsigned long long atualizado; // getMonotonicTime() da ultima iteracao.
+	unsigned long long tanques;    // GameData::getQuant().
+	unsigned long long projeteis;
+	unsigned long long disparos;   // Tiros criados, acumulado.
+	unsigned long long destruicoes; // Tanques removidos, acumulado.
+	TelemetriaHistograma tick;
+
+	// Desenho e entrada: uma vez por quadro, na thread do GL.
+	alignas(64) unsigned long long quadros;
+	unsigned long long filaEntrada;       // Eventos esperando a simulacao.
+	unsigned long long filaEntradaMax;
+	unsigned long long entradasDescartadas; // Acumulado (fila cheia).
+	TelemetriaHistograma quadro;
+} TelemetriaSegmento;
+
+// Cria (ou recria) o segmento 'nome'. Deve ser chamada antes de as threads
+// comecarem. Falso se nao foi possivel; o jogo segue sem telemetria.
+bool telemetryEnable(const char *nome);
+bool telemetryEnabled();
+
+// Desligada, cada uma custa um teste.
+void telemetryTick(long long duracao, int tanques, int projeteis, int disparos, int destruicoes);
+void telemetryFrame(long long duracao, unsigned int fila, long descartadas);
+
+// Desfaz o segmento. Chamar com as outras threads ja paradas.
+void telemetryFinish();
+
+// Le o segmento 'nome' de outro processo e imprime as taxas a cada segundo, por
+// 'segundos' segundos (0: ate o outro processo sumir).
+int runMonitor(const char *nome, int segundos);
+
+#endif /* TELEMETRY_H_ */
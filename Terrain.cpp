@@ -5,11 +5,120 @@
  *      Author: thaylo
  */
 
+#define GL_GLEXT_PROTOTYPES // glGenBuffers e cia. (GL 1.5).
+
 #include "Terrain.h"
+#include <vector>
+
+extern GLuint t[2];
+
+#define FLOATS_VERTICE 8 // T2F_N3F_V3F
+#define VERTICES_CHUNK (TERRAIN_SUBDIV*TERRAIN_SUBDIV*4)
+
+// Resto sempre positivo, para os pedacos de coordenada negativa.
+static int modulo(int a, int n)
+{
+	int r = a % n;
+	return r < 0 ? r + n : r;
+}
 
 Terrain::Terrain() {
+	pronto = false;
+	reconstruidos = 0;
+	for(int i = 0; i < TERRAIN_LADO; i++)
+	{
+		for(int j = 0; j < TERRAIN_LADO; j++)
+		{
+			chunks[i][j].valido = false;
+			buffers[i][j] = 0;
+		}
+	}
 }
 
-Terrain::~Terrain() {
+void Terrain::init()
+{
+	glGenBuffers(TERRAIN_LADO*TERRAIN_LADO, &buffers[0][0]);
+	for(int i = 0; i < TERRAIN_LADO; i++)
+	{
+		for(int j = 0; j < TERRAIN_LADO; j++)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, buffers[i][j]);
+			glBufferData(GL_ARRAY_BUFFER, VERTICES_CHUNK*FLOATS_VERTICE*sizeof(GLfloat), NULL, GL_STATIC_DRAW);
+		}
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	pronto = true;
 }
 
+// Monta no slot (sx, sy) a malha do pedaco (cx, cy), ja em coordenadas do mundo.
+void Terrain::build(int sx, int sy, int cx, int cy)
+{
+	std::vector<GLfloat> v;
+	v.reserve(VERTICES_CHUNK*FLOATS_VERTICE);
+
+	double passo = TERRAIN_CHUNK / TERRAIN_SUBDIV;
+	double x0 = cx*TERRAIN_CHUNK, y0 = cy*TERRAIN_CHUNK;
+	static const int cantos[4][2] = { {0,0}, {1,0}, {1,1}, {0,1} };
+	for(int i = 0; i < TERRAIN_SUBDIV; i++)
+	{
+		for(int j = 0; j < TERRAIN_SUBDIV; j++)
+		{
+			for(int k = 0; k < 4; k++)
+			{
+				int a = i + cantos[k][0], b = j + cantos[k][1];
+				v.push_back((x0 + a*passo) / TERRAIN_TEXTURA);
+				v.push_back((y0 + b*passo) / TERRAIN_TEXTURA);
+				v.push_back(0);
+				v.push_back(0);
+				v.push_back(1);
+				v.push_back(x0 + a*passo);
+				v.push_back(y0 + b*passo);
+				v.push_back(0);
+			}
+		}
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, buffers[sx][sy]);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, v.size()*sizeof(GLfloat), &v[0]);
+
+	chunks[sx][sy].cx = cx;
+	chunks[sx][sy].cy = cy;
+	chunks[sx][sy].valido = true;
+	reconstruidos++;
+}
+
+void Terrain::draw(const Vector &centro)
+{
+	if(!pronto) init();
+
+	int ccx = (int) floor(centro.getX() / TERRAIN_CHUNK);
+	int ccy = (int) floor(centro.getY() / TERRAIN_CHUNK);
+
+	glBindTexture(GL_TEXTURE_2D, t[0]);   // Escolhe a textura a ser usada.
+	glColor4f(1,1,1,0);
+	for(int cx = ccx - TERRAIN_RAIO; cx <= ccx + TERRAIN_RAIO; cx++)
+	{
+		for(int cy = ccy - TERRAIN_RAIO; cy <= ccy + TERRAIN_RAIO; cy++)
+		{
+			int sx = modulo(cx, TERRAIN_LADO), sy = modulo(cy, TERRAIN_LADO);
+			const Chunk &c = chunks[sx][sy];
+			if(!c.valido || c.cx != cx || c.cy != cy)
+			{
+				build(sx, sy, cx, cy);
+			}
+
+			glBindBuffer(GL_ARRAY_BUFFER, buffers[sx][sy]);
+			glInterleavedArrays(GL_T2F_N3F_V3F, 0, (const GLvoid *) 0);
+			glDrawArrays(GL_QUADS, 0, VERTICES_CHUNK);
+		}
+	}
+
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+Terrain::~Terrain() {
+	// Sem contexto de GL no fim do programa nao ha o que liberar.
+}
@@ -8,10 +8,53 @@
 #ifndef TERRAIN_H_
 #define TERRAIN_H_
 
+#include "GLDraw.h"
+#include "Vector.h"
+
+// Lado de um pedaco do chao, em unidades do mundo.
+#define TERRAIN_CHUNK 40.0
+// Lado coberto por uma repeticao da textura do chao, o mesmo do chao antigo de
+// 120 x 120. As coordenadas de textura saem da posicao no mundo, entao a
+// textura continua de um pedaco para o vizinho.
+#define TERRAIN_TEXTURA 120.0
+// Quads por lado de um pedaco (a iluminacao e por vertice).
+#define TERRAIN_SUBDIV 8
+// Pedacos carregados em cada direcao a partir do pedaco do centro.
+#define TERRAIN_RAIO 2
+#define TERRAIN_LADO (2*TERRAIN_RAIO + 1)
+
+// Chao em pedacos quadrados que acompanham o centro (o jogador). Ha sempre
+// TERRAIN_LADO x TERRAIN_LADO pedacos, cada um com o seu VBO; o pedaco (cx, cy)
+// mora no slot (cx mod LADO, cy mod LADO), entao ao andar so os pedacos da borda
+// que saiu sao refeitos, no lugar dos que entraram. Memoria e custo de desenho nao
+// dependem do tamanho da arena. Os recursos de GL so sao criados no primeiro draw().
 class Terrain {
+private:
+	typedef struct Chunk {
+		int cx, cy;
+		bool valido;
+	} Chunk;
+
+	Chunk chunks[TERRAIN_LADO][TERRAIN_LADO];
+	GLuint buffers[TERRAIN_LADO][TERRAIN_LADO];
+	bool pronto;
+	int reconstruidos;
+
+	void init();
+	void build(int sx, int sy, int cx, int cy);
+
+	Terrain(const Terrain &);
+	Terrain &operator=(const Terrain &);
+
 public:
 	Terrain();
 
+	// Garante os pedacos em volta de 'centro' e desenha todos.
+	void draw(const Vector &centro);
+
+	// Quantos pedacos ja foram montados desde o inicio.
+	int getReconstruidos() const { return reconstruidos; }
+
 	~Terrain();
 };
 
@@ -0,0 +1,148 @@
+/*
+ * TexFile.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "TexFile.h"
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static unsigned int metade(unsigned int n)
+{
+	return n > 1 ? n/2 : 1;
+}
+
+// Reduz pela metade com a media de cada bloco 2x2 (numa dimensao impar a ultima
+// linha ou coluna entra repetida).
+static void reduz(const unsigned char *src, unsigned int w, unsigned int h, unsigned char *dst)
+{
+	unsigned int nw = metade(w), nh = metade(h);
+	for(unsigned int y = 0; y < nh; y++)
+	{
+		unsigned int y0 = 2*y < h ? 2*y : h - 1;
+		unsigned int y1 = 2*y + 1 < h ? 2*y + 1 : h - 1;
+		for(unsigned int x = 0; x < nw; x++)
+		{
+			unsigned int x0 = 2*x < w ? 2*x : w - 1;
+			unsigned int x1 = 2*x + 1 < w ? 2*x + 1 : w - 1;
+			for(int c = 0; c < 3; c++)
+			{
+				unsigned int soma = src[(y0*w + x0)*3 + c] + src[(y0*w + x1)*3 + c]
+				                  + src[(y1*w + x0)*3 + c] + src[(y1*w + x1)*3 + c];
+				dst[(y*nw + x)*3 + c] = (unsigned char) ((soma + 2)/4);
+			}
+		}
+	}
+}
+
+int writeTexFile(const char *path, const unsigned char *bgr, unsigned int largura, unsigned int altura)
+{
+	if(largura == 0 || altura == 0) return 0;
+
+	TexHeader h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, TEX_MAGIC, 4);
+	h.formato = TEX_FORMATO_BGR;
+	h.largura = largura;
+	h.altura = altura;
+
+	// Todos os niveis em memoria, um atras do outro.
+	std::vector<unsigned char> dados(bgr, bgr + (size_t) largura*altura*3);
+	unsigned int w = largura, hh = altura;
+	size_t inicio = 0;
+	h.offset[0] = sizeof(TexHeader);
+	h.niveis = 1;
+	while((w > 1 || hh > 1) && h.niveis < TEX_MAX_LEVELS)
+	{
+		size_t tamanho = (size_t) w*hh*3;
+		dados.resize(inicio + tamanho + (size_t) metade(w)*metade(hh)*3);
+		reduz(&dados[inicio], w, hh, &dados[inicio + tamanho]);
+		inicio += tamanho;
+		w = metade(w);
+		hh = metade(hh);
+		h.offset[h.niveis++] = sizeof(TexHeader) + inicio;
+	}
+
+	FILE *f = fopen(path, "wb");
+	if(f == NULL)
+	{
+		printf("Nao foi possivel criar %s\n", path);
+		return 0;
+	}
+	int ok = fwrite(&h, sizeof(h), 1, f) == 1 && fwrite(&dados[0], dados.size(), 1, f) == 1;
+	if(fclose(f) != 0) ok = 0;
+	if(!ok) printf("Erro gravando %s\n", path);
+	return ok;
+}
+
+int mapTexFile(const char *path, TexFile *tf)
+{
+	tf->mapa = NULL;
+	tf->tamanho = 0;
+	tf->header = NULL;
+
+	int fd = open(path, O_RDONLY);
+	if(fd < 0) return 0;
+
+	struct stat st;
+	if(fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(TexHeader))
+	{
+		close(fd);
+		return 0;
+	}
+	// MAP_POPULATE le o arquivo ja aqui, e nao durante o glTexImage2D.
+	void *mapa = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+	close(fd); // O mapeamento continua valido sem o descritor.
+	if(mapa == MAP_FAILED) return 0;
+
+	tf->mapa = mapa;
+	tf->tamanho = st.st_size;
+	tf->header = (const TexHeader *) mapa;
+
+	// Confere se cada nivel cabe no arquivo antes de entregar ao GL.
+	const TexHeader *h = tf->header;
+	int ok = memcmp(h->magic, TEX_MAGIC, 4) == 0 && h->formato == TEX_FORMATO_BGR
+	      && h->largura > 0 && h->altura > 0 && h->niveis > 0 && h->niveis <= TEX_MAX_LEVELS;
+	unsigned int w = h->largura, hh = h->altura;
+	for(unsigned int i = 0; ok && i < h->niveis; i++)
+	{
+		ok = h->offset[i] >= sizeof(TexHeader) && h->offset[i] + (size_t) w*hh*3 <= tf->tamanho;
+		w = metade(w);
+		hh = metade(hh);
+	}
+	if(!ok)
+	{
+		printf("%s invalido, use o BMP\n", path);
+		unmapTexFile(tf);
+		return 0;
+	}
+	return 1;
+}
+
+const unsigned char *texLevel(const TexFile *tf, unsigned int nivel, unsigned int *largura, unsigned int *altura)
+{
+	unsigned int w = tf->header->largura, h = tf->header->altura;
+	for(unsigned int i = 0; i < nivel; i++)
+	{
+		w = metade(w);
+		h = metade(h);
+	}
+	*largura = w;
+	*altura = h;
+	return (const unsigned char *) tf->mapa + tf->header->offset[nivel];
+}
+
+void unmapTexFile(TexFile *tf)
+{
+	if(tf->mapa != NULL) munmap(tf->mapa, tf->tamanho);
+	tf->mapa = NULL;
+	tf->tamanho = 0;
+	tf->header = NULL;
+}
@@ -0,0 +1,47 @@
+/*
+ * TexFile.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef TEXFILE_H_
+#define TEXFILE_H_
+
+#include <stddef.h>
+
+// Formato .tex: a textura ja pronta para o glTexImage2D. Depois do cabecalho vem
+// cada nivel de mipmap, do maior ao 1x1, em BGR de 8 bits com as linhas juntas
+// (GL_UNPACK_ALIGNMENT 1). E gerado pelo texconv a partir do BMP e mapeado na
+// memoria ao carregar, sem conversao nenhuma.
+#define TEX_MAGIC "TEX1"
+#define TEX_MAX_LEVELS 16
+#define TEX_FORMATO_BGR 0x80E0 // GL_BGR
+
+typedef struct TexHeader {
+	char magic[4];
+	unsigned int formato;
+	unsigned int largura;
+	unsigned int altura;
+	unsigned int niveis;
+	unsigned int offset[TEX_MAX_LEVELS]; // Inicio de cada nivel, a partir do comeco do arquivo.
+} TexHeader;
+
+typedef struct TexFile {
+	void *mapa;
+	size_t tamanho;
+	const TexHeader *header;
+} TexFile;
+
+// Grava 'bgr' (largura x altura, linhas juntas) e todos os seus mipmaps em 'path'.
+int writeTexFile(const char *path, const unsigned char *bgr, unsigned int largura, unsigned int altura);
+
+// Mapeia e valida um .tex. Devolve 0 se o arquivo nao existe ou nao confere.
+int mapTexFile(const char *path, TexFile *tf);
+
+// Pixels do nivel 'nivel' e suas dimensoes.
+const unsigned char *texLevel(const TexFile *tf, unsigned int nivel, unsigned int *largura, unsigned int *altura);
+
+void unmapTexFile(TexFile *tf);
+
+#endif /* TEXFILE_H_ */
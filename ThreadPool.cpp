@@ -0,0 +1,103 @@
+/*
+ * ThreadPool.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threads)
+{
+	if(threads <= 0)
+	{
+		threads = (int) std::thread::hardware_concurrency();
+		if(threads <= 0) threads = 1;
+	}
+
+	task = NULL;
+	ctx = NULL;
+	quant = grain = 0;
+	proximo = 0;
+	pendentes = 0;
+	geracao = 0;
+	parar = false;
+
+	for(int i = 1; i < threads; i++)
+	{
+		workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+	}
+}
+
+void ThreadPool::runChunks(int worker)
+{
+	while(true)
+	{
+		int begin = proximo.fetch_add(grain);
+		if(begin >= quant) break;
+		int end = begin + grain < quant ? begin + grain : quant;
+		task(begin, end, worker, ctx);
+	}
+}
+
+void ThreadPool::workerLoop(int worker)
+{
+	long vista = 0;
+	while(true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m);
+			while(!parar && geracao == vista) inicio.wait(lock);
+			if(parar) return;
+			vista = geracao;
+		}
+
+		runChunks(worker);
+
+		std::lock_guard<std::mutex> lock(m);
+		if(--pendentes == 0) fim.notify_one();
+	}
+}
+
+void ThreadPool::parallelFor(int n, int grain_, ThreadTask task_, void *ctx_)
+{
+	if(n <= 0) return;
+	if(grain_ < 1) grain_ = 1;
+
+	// Pouco trabalho ou nenhuma thread extra: roda direto, sem sincronizar.
+	if(workers.empty() || n <= grain_)
+	{
+		task_(0, n, 0, ctx_);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m);
+		task = task_;
+		ctx = ctx_;
+		quant = n;
+		grain = grain_;
+		proximo = 0;
+		pendentes = (int) workers.size();
+		geracao++;
+	}
+	inicio.notify_all();
+
+	runChunks(0);
+
+	std::unique_lock<std::mutex> lock(m);
+	while(pendentes > 0) fim.wait(lock);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m);
+		parar = true;
+	}
+	inicio.notify_all();
+	for(unsigned int i = 0; i < workers.size(); i++)
+	{
+		workers[i].join();
+	}
+}
@@ -0,0 +1,56 @@
+/*
+ * ThreadPool.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// Tarefa de um parallelFor: processa os indices [begin, end) na thread 'worker'
+// (0 e a thread que chamou parallelFor, 1..N-1 as do pool).
+typedef void (*ThreadTask)(int begin, int end, int worker, void *ctx);
+
+// Pool fixo de threads para laços paralelos. A thread que chama parallelFor
+// tambem trabalha, e os pedaços de 'grain' indices sao distribuidos sob demanda.
+class ThreadPool {
+private:
+	std::vector<std::thread> workers;
+	std::mutex m;
+	std::condition_variable inicio;
+	std::condition_variable fim;
+
+	ThreadTask task;
+	void *ctx;
+	int quant;
+	int grain;
+	std::atomic<int> proximo;
+	int pendentes;
+	long geracao;
+	bool parar;
+
+	void workerLoop(int worker);
+	void runChunks(int worker);
+
+	ThreadPool(const ThreadPool &);
+	ThreadPool &operator=(const ThreadPool &);
+
+public:
+	// threads <= 0 usa a quantidade de nucleos da maquina.
+	ThreadPool(int threads);
+
+	int getThreads() const { return (int) workers.size() + 1; }
+
+	void parallelFor(int n, int grain_, ThreadTask task_, void *ctx_);
+
+	~ThreadPool();
+};
+
+#endif /* THREADPOOL_H_ */
@@ -1,17 +1,19 @@
 #include "Timer.h"
+#include <time.h>
 
 long int getCurrentTime(){
 	 struct timeval now;
 	 long int seconds, useconds;    
 
-    gettimeofday(&now, (timezone*) 0);
+    gettimeofday(&now, (struct timezone*) 0);
 
     seconds  = now.tv_sec;
     useconds = now.tv_usec;
 	 return ((seconds) * 1000 + useconds/1000.0) + 0.5;
 }
 
-
-
-
-
+long long getMonotonicTime(){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long) now.tv_sec * 1000000000LL + now.tv_nsec;
+}
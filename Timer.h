@@ -5,4 +5,7 @@
 
 long int getCurrentTime();
 
+// Relogio monotonico em nanossegundos, para medir intervalos curtos.
+long long getMonotonicTime();
+
 #endif
@@ -12,52 +12,207 @@
 #include <iostream>
 #include <cmath>
 
-using namespace std;
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
+using namespace std;
 
+// Tudo inline: a matematica de vetores esta em todos os lacos quentes do jogo e
+// precisa ser vista pelo compilador para ser otimizada (e vetorizada) no lugar.
 class Vector{
 
 public:
 
-	Vector();
-	Vector(double xv, double yv, double zv);
-	double getX()const ;
-	double getY()const ;
-	double getZ()const ;
-
-	double setX(double xv);
-	double setY(double yv);
-	double setZ(double yv);
-
-	Vector operator+(const Vector &v2)const ;
-	Vector operator=(const Vector &v2);
-	Vector operator=(double k);
-	Vector operator-(const Vector &v2)const ;
-
-
-	Vector operator*(double k)const ;
-	Vector operator/(double k)const ;
-
-	double getLengthVector()const ;
+	constexpr Vector() : x(0), y(0), z(0) {}
+	constexpr Vector(double xv, double yv, double zv) : x(xv), y(yv), z(zv) {}
+	Vector(const Vector &v2) = default;
+	constexpr double getX()const { return x; }
+	constexpr double getY()const { return y; }
+	constexpr double getZ()const { return z; }
+
+	double setX(double xv) { return(x = xv); }
+	double setY(double yv) { return(y = yv); }
+	double setZ(double zv) { return(z = zv); }
+
+	constexpr Vector operator+(const Vector &v2)const { return Vector(x + v2.x, y + v2.y, z + v2.z); }
+	constexpr Vector operator-(const Vector &v2)const { return Vector(x - v2.x, y - v2.y, z - v2.z); }
+	Vector &operator=(const Vector &v2) = default;
+	Vector &operator=(double k);
+
+	constexpr Vector operator*(double k)const { return Vector(x*k, y*k, z*k); }
+	constexpr Vector operator/(double k)const { return Vector(x/k, y/k, z/k); }
+
+	// Para comparar distancias nao e preciso tirar a raiz.
+	constexpr double getLengthSquared()const { return x*x + y*y + z*z; }
+	double getLengthVector()const { return sqrt(getLengthSquared()); }
+	// Muda o comprimento deste vetor (se nao for nulo) e devolve o resultado.
 	Vector setVectorLength(double length);
-
-	double distanceVector(const Vector &v2)const ;
-
-
-
-	double dotProduct(const Vector &B)const ;
-	Vector getNormalVector()const ;
-	Vector crossProduct(const Vector &v) const;
-	double angleVectors(const Vector &v) const;
-	Vector rotateVector(const Vector &v, double theta_rad);
+	// Copia unitaria deste vetor (o proprio vetor se for nulo).
+	Vector normalized()const;
+
+	double distanceVector(const Vector &v2)const { return (*this - v2).getLengthVector(); }
+
+	constexpr double dotProduct(const Vector &B)const { return x*B.x + y*B.y + z*B.z; }
+	Vector getNormalVector()const { return Vector(-y,x,0).normalized(); }
+	constexpr Vector crossProduct(const Vector &v) const
+	{
+		return Vector(y*v.z - z*v.y, z*v.x - x*v.z, x*v.y - y*v.x);
+	}
+	double angleVectors(const Vector &v) const { return atan2(crossProduct(v).getLengthVector(), dotProduct(v)); }
+	Vector rotateVector(const Vector &v, double theta_rad) const;
 	double getArea3Vectors(const Vector &vec2, const Vector &vec3)const ;
 
-	~Vector();
-
 private:
 	double x,y,z;
 };
 
-ostream& operator<<(ostream& output, const Vector& p);
+inline Vector &Vector::operator=(double k)
+{
+	if(k != 0)
+	{
+		cout << "Atribuicao invalida de double -> Vector\n";
+	}
+	x = y = z = 0;
+	return *this;
+}
+
+inline Vector Vector::setVectorLength(double length)
+{
+	double quadrado = getLengthSquared();
+	if(quadrado != 0)
+	{
+		double k = length/sqrt(quadrado);
+		x *= k;
+		y *= k;
+		z *= k;
+	}
+	return *this;
+}
+
+inline Vector Vector::normalized()const
+{
+	Vector r = *this;
+	return r.setVectorLength(1.0);
+}
+
+// IN RADIANS. Formula de Rodrigues: um seno e um cosseno, sem montar a matriz.
+inline Vector Vector::rotateVector(const Vector &v, double phi) const
+{
+	Vector u = v.normalized();
+	double c = cos(phi), s = sin(phi);
+	return (*this)*c + u.crossProduct(*this)*s + u*(u.dotProduct(*this)*(1 - c));
+}
+
+inline ostream& operator<<(ostream& output, const Vector& p) {
+    output << "(" <<  p.getX() << ", " << p.getY() << ", " << p.getZ() << ")" ;
+    return output;  // for multiple << operators.
+}
+
+// Menor distancia ao quadrado da origem ao segmento [a, b]. Com a e b sendo a
+// posicao relativa entre dois corpos no inicio e no fim de um passo, e o quao
+// perto eles chegaram durante o passo (teste continuo, sem tunelamento).
+inline double segmentDistanceSquared(const Vector &a, const Vector &b)
+{
+	Vector ab = b - a;
+	double comprimento2 = ab.getLengthSquared();
+	double t = comprimento2 > 0 ? -a.dotProduct(ab)/comprimento2 : 0;
+	if(t < 0) t = 0;
+	else if(t > 1) t = 1;
+	return (a + ab*t).getLengthSquared();
+}
+
+// Todos os corpos andam no plano: o estado quente guarda so x e y, em float. Os
+// Vector de fora entram e saem com z = 0.
+typedef struct Vec2f {
+	float x, y;
+} Vec2f;
+
+inline Vec2f toVec2f(const Vector &v)
+{
+	Vec2f r = { (float) v.getX(), (float) v.getY() };
+	return r;
+}
+
+inline Vector toVector(const Vec2f &v)
+{
+	return Vector(v.x, v.y, 0);
+}
+
+// Nucleos para colunas inteiras de Vec2f (as do EntityStore e do
+// ProjectileSystem): n vetores sao 2n floats contiguos.
+static_assert(sizeof(Vec2f) == 2*sizeof(float), "Vec2f deve ser dois floats sem enchimento");
+
+// p[i] += v[i]*dt
+inline void integratePositions(Vec2f *p, const Vec2f *v, int n, float dt)
+{
+	float *a = &p->x;
+	const float *b = &v->x;
+	int total = 2*n, i = 0;
+#if defined(__SSE2__)
+	__m128 k = _mm_set1_ps(dt);
+	for(; i + 4 <= total; i += 4)
+	{
+		_mm_storeu_ps(a + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_mul_ps(_mm_loadu_ps(b + i), k)));
+	}
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+	float32x4_t k = vdupq_n_f32(dt);
+	for(; i + 4 <= total; i += 4)
+	{
+		vst1q_f32(a + i, vaddq_f32(vld1q_f32(a + i), vmulq_f32(vld1q_f32(b + i), k)));
+	}
+#endif
+	for(; i < total; i++)
+	{
+		a[i] += b[i]*dt;
+	}
+}
+
+// v[i] = v[i] + acel[i]*dt - v[i]*atrito*dt, na mesma ordem de operacoes do laco antigo.
+inline void integrateVelocities(Vec2f *v, const Vec2f *acel, int n, float atrito, float dt)
+{
+	float *a = &v->x;
+	const float *b = &acel->x;
+	int total = 2*n, i = 0;
+#if defined(__SSE2__)
+	__m128 kdt = _mm_set1_ps(dt), kat = _mm_set1_ps(atrito);
+	for(; i + 4 <= total; i += 4)
+	{
+		__m128 va = _mm_loadu_ps(a + i);
+		__m128 r = _mm_add_ps(va, _mm_mul_ps(_mm_loadu_ps(b + i), kdt));
+		_mm_storeu_ps(a + i, _mm_sub_ps(r, _mm_mul_ps(_mm_mul_ps(va, kat), kdt)));
+	}
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+	float32x4_t kdt = vdupq_n_f32(dt), kat = vdupq_n_f32(atrito);
+	for(; i + 4 <= total; i += 4)
+	{
+		float32x4_t va = vld1q_f32(a + i);
+		float32x4_t r = vaddq_f32(va, vmulq_f32(vld1q_f32(b + i), kdt));
+		vst1q_f32(a + i, vsubq_f32(r, vmulq_f32(vmulq_f32(va, kat), kdt)));
+	}
+#endif
+	for(; i < total; i++)
+	{
+		a[i] = a[i] + b[i]*dt - a[i]*atrito*dt;
+	}
+}
+
+// Limita o comprimento de cada vetor a 'maximo', sem raiz para quem ja esta abaixo.
+inline void clampLengths(Vec2f *v, int n, float maximo)
+{
+	float limite = maximo*maximo;
+	for(int i = 0; i < n; i++)
+	{
+		float q = v[i].x*v[i].x + v[i].y*v[i].y;
+		if(q > limite)
+		{
+			float k = maximo / sqrtf(q);
+			v[i].x *= k;
+			v[i].y *= k;
+		}
+	}
+}
 
 #endif // Vector.h
@@ -1,4 +1,16 @@
 #include "Window.h"
+#include <string.h>
+
+// A lista de extensoes vem separada por espacos; um strstr sozinho aceitaria prefixos.
+static bool temExtensao(const char *lista, const char *nome)
+{
+	size_t n = strlen(nome);
+	for(const char *p = lista; p != NULL && (p = strstr(p, nome)) != NULL; p += n)
+	{
+		if((p == lista || p[-1] == ' ') && (p[n] == ' ' || p[n] == '\0')) return true;
+	}
+	return false;
+}
 
 window::window()
 {
@@ -98,7 +110,6 @@ window::window()
 									KeyReleaseMask         |
 									ButtonPressMask        |
 									ButtonReleaseMask      |
-									PointerMotionMask      |
 									StructureNotifyMask    |
 									SubstructureNotifyMask |
 									FocusChangeMask;
@@ -129,6 +140,39 @@ window::window()
 
 	// Request the X window to be displayed on the screen
 	XMapWindow( g_pDisplay, g_window );
+
+	// Swap interval: EXT vale por janela e aceita 0; MESA tambem; SGI so aceita >= 1.
+	const char *extensoes = glXQueryExtensionsString( g_pDisplay, visualInfo->screen );
+	swapIntervalEXT = NULL;
+	swapIntervalMESA = NULL;
+	swapIntervalSGI = NULL;
+	if( temExtensao(extensoes, "GLX_EXT_swap_control") )
+		swapIntervalEXT = (void (*)(Display *, GLXDrawable, int)) glXGetProcAddress( (const GLubyte *) "glXSwapIntervalEXT" );
+	else if( temExtensao(extensoes, "GLX_MESA_swap_control") )
+		swapIntervalMESA = (int (*)(unsigned int)) glXGetProcAddress( (const GLubyte *) "glXSwapIntervalMESA" );
+	else if( temExtensao(extensoes, "GLX_SGI_swap_control") )
+		swapIntervalSGI = (int (*)(int)) glXGetProcAddress( (const GLubyte *) "glXSwapIntervalSGI" );
+	swapInterval = -1; // Desconhecido: o padrao do driver.
+	setSwapInterval( 1 );
+}
+
+bool window::setSwapInterval(int intervalo)
+{
+	if( intervalo == swapInterval ) return true;
+	if( swapIntervalEXT != NULL )
+		swapIntervalEXT( g_pDisplay, g_window, intervalo );
+	else if( swapIntervalMESA != NULL )
+	{
+		if( swapIntervalMESA( intervalo ) != 0 ) return false;
+	}
+	else if( swapIntervalSGI != NULL && intervalo > 0 )
+	{
+		if( swapIntervalSGI( intervalo ) != 0 ) return false;
+	}
+	else
+		return false;
+	swapInterval = intervalo;
+	return true;
 }
 
 bool window::processWindow(void (*mouseFunc)(int type, int button, int x, int y), void (*keyPress)(int code), void (*keyRelease)(int code))
@@ -155,7 +199,6 @@ bool window::processWindow(void (*mouseFunc)(int type, int button, int x, int y)
 				keyRelease(code);
 			}break;
 
-			case MotionNotify:
 			case ButtonPress:
 			case ButtonRelease:
 			{
@@ -186,6 +229,16 @@ bool window::processWindow(void (*mouseFunc)(int type, int button, int x, int y)
 
 }
 
+int window::getConnectionFd()
+{
+	return ConnectionNumber(g_pDisplay);
+}
+
+bool window::hasQueuedEvents()
+{
+	return XEventsQueued(g_pDisplay, QueuedAfterFlush) > 0;
+}
+
 void window::showWindow()
 {	
 	if( g_bDoubleBuffered )
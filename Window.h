@@ -16,9 +16,22 @@ private:
 	Display* g_pDisplay;
 	Window g_window;
 	int g_bDoubleBuffered;
+	// Extensao usada para o swap interval, achada em window(); NULL: nenhuma.
+	void (*swapIntervalEXT)(Display *, GLXDrawable, int);
+	int (*swapIntervalMESA)(unsigned int);
+	int (*swapIntervalSGI)(int);
+	int swapInterval;
 public:
 	window();
 	void showWindow();
+	// Quantos periodos da tela cada troca de buffers espera (0: nao espera o
+	// vsync). Falso se o driver nao deixa escolher esse valor.
+	bool setSwapInterval(int intervalo);
+	int getSwapInterval() const { return swapInterval; }
+	// Descritor da conexao com o X, para esperar eventos com poll().
+	int getConnectionFd();
+	// Ha eventos ja lidos do socket esperando na fila do Xlib?
+	bool hasQueuedEvents();
 	~window(){	}
 	bool processWindow(void (*mouseFunc)(int type, int button, int x, int y), void (*keyPress)(int code), void (*keyRelease)(int code));
 };
@@ -0,0 +1,115 @@
+/*
+ * WorldFile.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#include "WorldFile.h"
+#include "Constants.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define WORLD_ALINHAMENTO 16
+
+static unsigned long long alinha(unsigned long long n)
+{
+	return (n + WORLD_ALINHAMENTO - 1) / WORLD_ALINHAMENTO * WORLD_ALINHAMENTO;
+}
+
+int writeWorldFile(const char *path, WorldHeader *h, const Coluna *colunas)
+{
+	memcpy(h->magic, WORLD_MAGIC, 4);
+	h->versao = WORLD_VERSAO;
+	h->passo = TIME_STEP;
+
+	unsigned long long fim = alinha(sizeof(WorldHeader));
+	for(int i = 0; i < WORLD_SECOES; i++)
+	{
+		h->secao[i].offset = fim;
+		h->secao[i].tamanho = colunas[i].tamanho;
+		h->secao[i].quant = colunas[i].quant;
+		fim = alinha(fim + (unsigned long long) colunas[i].tamanho * colunas[i].quant);
+	}
+
+	FILE *f = fopen(path, "wb");
+	if(f == NULL)
+	{
+		printf("Nao foi possivel criar %s\n", path);
+		return 0;
+	}
+	static const char zeros[WORLD_ALINHAMENTO] = { 0 };
+	int ok = fwrite(h, sizeof(WorldHeader), 1, f) == 1;
+	unsigned long long escrito = sizeof(WorldHeader);
+	for(int i = 0; ok && i < WORLD_SECOES; i++)
+	{
+		size_t enchimento = h->secao[i].offset - escrito;
+		size_t bytes = (size_t) colunas[i].tamanho * colunas[i].quant;
+		ok = (enchimento == 0 || fwrite(zeros, enchimento, 1, f) == 1)
+		  && (bytes == 0 || fwrite(colunas[i].dados, bytes, 1, f) == 1);
+		escrito = h->secao[i].offset + bytes;
+	}
+	if(fclose(f) != 0) ok = 0;
+	if(!ok) printf("Erro gravando %s\n", path);
+	return ok;
+}
+
+int mapWorldFile(const char *path, WorldFile *wf)
+{
+	wf->mapa = NULL;
+	wf->tamanho = 0;
+	wf->header = NULL;
+
+	int fd = open(path, O_RDONLY);
+	if(fd < 0) return 0;
+
+	struct stat st;
+	if(fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(WorldHeader))
+	{
+		close(fd);
+		return 0;
+	}
+	void *mapa = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+	close(fd);
+	if(mapa == MAP_FAILED) return 0;
+
+	wf->mapa = mapa;
+	wf->tamanho = st.st_size;
+	wf->header = (const WorldHeader *) mapa;
+
+	const WorldHeader *h = wf->header;
+	int ok = memcmp(h->magic, WORLD_MAGIC, 4) == 0 && h->versao == WORLD_VERSAO && h->passo == TIME_STEP;
+	for(int i = 0; ok && i < WORLD_SECOES; i++)
+	{
+		const WorldSecao &s = h->secao[i];
+		ok = s.offset >= sizeof(WorldHeader) && s.offset % WORLD_ALINHAMENTO == 0
+		  && s.offset + (unsigned long long) s.tamanho * s.quant <= wf->tamanho;
+	}
+	if(!ok)
+	{
+		printf("%s invalido ou de outra versao\n", path);
+		unmapWorldFile(wf);
+		return 0;
+	}
+	return 1;
+}
+
+int copyWorldSection(const WorldFile *wf, int i, const Coluna &destino)
+{
+	const WorldSecao &s = wf->header->secao[i];
+	if(s.tamanho != destino.tamanho || s.quant > destino.quant) return 0;
+	if(s.quant > 0) memcpy(destino.dados, (const char *) wf->mapa + s.offset, (size_t) s.tamanho * s.quant);
+	return 1;
+}
+
+void unmapWorldFile(WorldFile *wf)
+{
+	if(wf->mapa != NULL) munmap(wf->mapa, wf->tamanho);
+	wf->mapa = NULL;
+	wf->tamanho = 0;
+	wf->header = NULL;
+}
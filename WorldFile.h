@@ -0,0 +1,93 @@
+/*
+ * WorldFile.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+#ifndef WORLDFILE_H_
+#define WORLDFILE_H_
+
+#include <stddef.h>
+
+// Formato .wld: o estado inteiro de um GameData no fim de uma iteracao. Depois do
+// cabecalho vem cada coluna do EntityStore, o estado de cada Agent e as colunas
+// do ProjectileSystem, cada secao como esta na memoria (alinhada em 16 bytes),
+// entao gravar e uma escrita sequencial e carregar e mapear o arquivo e copiar
+// cada secao direto para a coluna, sem interpretar nada.
+#define WORLD_MAGIC "WLD1"
+#define WORLD_VERSAO 3
+
+#define WORLD_COLUNAS_ENTIDADES 11             // EntityStore::getColunas().
+#define WORLD_SECAO_AGENTES WORLD_COLUNAS_ENTIDADES
+#define WORLD_SECAO_TIROS (WORLD_SECAO_AGENTES + 1)
+#define WORLD_COLUNAS_TIROS 5                  // ProjectileSystem::getColunas().
+#define WORLD_SECOES (WORLD_SECAO_TIROS + WORLD_COLUNAS_TIROS)
+#define WORLD_MAX_CORPOS (1 << 22)          // Por secao; acima disso o arquivo e recusado.
+
+// Uma coluna em memoria: 'quant' elementos de 'tamanho' bytes a partir de 'dados'.
+typedef struct Coluna {
+	void *dados;
+	unsigned int tamanho;
+	unsigned int quant;
+} Coluna;
+
+typedef struct WorldSecao {
+	unsigned long long offset; // A partir do comeco do arquivo.
+	unsigned int tamanho;      // De um elemento; confere com o do executavel.
+	unsigned int quant;
+} WorldSecao;
+
+// O que nao esta nas colunas. Referencias entre agentes sao slots (-1 e nenhum).
+typedef struct AgentEstado {
+	int recarga;
+	int maisProximo;
+	int alvo;          // Alvo fixo de um Enemy.
+	int fase;
+	int giroRestante;
+	unsigned char destruir;
+	unsigned char radar;
+	unsigned char cacador;
+	unsigned char pensar;
+	unsigned char atrasado;
+	unsigned char reservado[3];
+} AgentEstado;
+
+typedef struct WorldHeader {
+	char magic[4];
+	unsigned int versao;
+	int passo;               // TIME_STEP de quem gravou.
+	int jogador;             // Slot do jogador.
+	int jogadorIA;
+	int estadoJogo;
+	unsigned int semente;
+	int cursorIA;
+	long long iteracao;
+	long long decisoesIA;
+	long long disparos;
+	int picoTiros;
+	int reservado;
+	WorldSecao secao[WORLD_SECOES];
+} WorldHeader;
+
+typedef struct WorldFile {
+	void *mapa;
+	size_t tamanho;
+	const WorldHeader *header;
+} WorldFile;
+
+// Grava 'h' (os offsets e tamanhos das secoes sao preenchidos aqui) seguido das
+// WORLD_SECOES colunas.
+int writeWorldFile(const char *path, WorldHeader *h, const Coluna *colunas);
+
+// Mapeia e valida um .wld gravado com este TIME_STEP. Devolve 0 se o arquivo nao
+// existe ou nao confere.
+int mapWorldFile(const char *path, WorldFile *wf);
+
+// Copia a secao 'i' para 'destino', que precisa ter o mesmo tamanho de elemento
+// e espaco para a quantidade gravada. Devolve 0 se o tamanho nao confere.
+int copyWorldSection(const WorldFile *wf, int i, const Coluna &destino);
+
+void unmapWorldFile(WorldFile *wf);
+
+#endif /* WORLDFILE_H_ */
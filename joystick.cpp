@@ -52,93 +52,103 @@ int processaJoystick(int *buttons, struct js_event* jse)
 	//usleep(1000);
 	if (rc == 1)
 	{
-		if(jse->type == JS_EVENT_BUTTON)
+		decodeJoystickEvent(buttons, jse);
+	}
+
+	return 0;
+}
+
+/* Traduz um evento em botoes: os dois eixos do direcional viram JOYPAD_UP..JOYPAD_LEFT. */
+void decodeJoystickEvent(int *buttons, const struct js_event* jse)
+{
+	unsigned char type = jse->type & ~JS_EVENT_INIT; /* O estado inicial vale como evento normal. */
+	if (jse->number >= JOYPAD_BUTTONS && type == JS_EVENT_BUTTON)
+		return;
+
+	if(type == JS_EVENT_BUTTON)
+	{
+		if(jse->value == 1)
 		{
-			if(jse->value == 1)
+			//printf("Button pressed\n");
+			//printf("Event: Value %hd, type: %u, axis/button: %u\n", jse->value, jse->type, jse->number);
+			buttons[jse->number] = 1;
+			
+
+		}
+		else if(jse->value == 0)
+		{
+			//printf("Button released\n");
+			//printf("Event: Value %hd, type: %u, axis/button: %u\n", jse->value, jse->type, jse->number);
+			buttons[jse->number] = 0;
+		}
+	}
+	else if(type == JS_EVENT_AXIS)
+	{
+			
+		if(jse->number == 5)
+		{
+			//printf("3st Axis X\n");
+			
+			
+			if(jse->value != 0)
 			{
-				//printf("Button pressed\n");
+				//printf("Directional pressed\n");
 				//printf("Event: Value %hd, type: %u, axis/button: %u\n", jse->value, jse->type, jse->number);
-				buttons[jse->number] = 1;
-				
-	
+				if(jse->value == 32767)
+				{
+					buttons[JOYPAD_RIGHT] = 1;
+				}
+				else if(jse->value == -32767)
+				{
+					buttons[JOYPAD_LEFT] = 1;
+				}
+
 			}
 			else if(jse->value == 0)
 			{
-				//printf("Button released\n");
+				//printf("Directional released\n");
 				//printf("Event: Value %hd, type: %u, axis/button: %u\n", jse->value, jse->type, jse->number);
-				buttons[jse->number] = 0;
+				if(jse->number == 5)
+				{
+					buttons[JOYPAD_RIGHT] = buttons[JOYPAD_LEFT] = 0;
+				}
 			}
 		}
-		else if(jse->type == JS_EVENT_AXIS)
+		else if(jse->number == 6)
 		{
-				
-			if(jse->number == 5)
+			if(jse->value != 0)
 			{
-				//printf("3st Axis X\n");
 				
-				
-				if(jse->value != 0)
+				//printf("Directional pressed\n");
+				//printf("Event: Value %hd, type: %u, axis/button: %u\n", jse->value, jse->type, jse->number);
+				if(jse->value == -32767)
 				{
-					//printf("Directional pressed\n");
-					//printf("Event: Value %hd, type: %u, axis/button: %u\n", jse->value, jse->type, jse->number);
-					if(jse->value == 32767)
-					{
-						buttons[9] = 1;
-					}
-					else if(jse->value == -32767)
-					{
-						buttons[11] = 1;
-					}
-
+					buttons[JOYPAD_UP] = 1;
 				}
-				else if(jse->value == 0)
+
+				else if(jse->value == 32767)
 				{
-					//printf("Directional released\n");
-					//printf("Event: Value %hd, type: %u, axis/button: %u\n", jse->value, jse->type, jse->number);
-					if(jse->number == 5)
-					{
-						buttons[9] = buttons[11] = 0;
-					}
+					buttons[JOYPAD_DOWN] = 1;
 				}
 			}
-			else if(jse->number == 6)
+			else
 			{
-				if(jse->value != 0)
-				{
-					
-					//printf("Directional pressed\n");
-					//printf("Event: Value %hd, type: %u, axis/button: %u\n", jse->value, jse->type, jse->number);
-					if(jse->value == -32767)
-					{
-						buttons[8] = 1;
-					}
-
-					else if(jse->value == 32767)
-					{
-						buttons[10] = 1;
-					}
-				}
-				else
+				//printf("Directional released\n");
+				//printf("Event: Value %hd, type: %u, axis/button: %u\n", jse->value, jse->type, jse->number);
+				if(jse->number == 6)
 				{
-					//printf("Directional released\n");
-					//printf("Event: Value %hd, type: %u, axis/button: %u\n", jse->value, jse->type, jse->number);
-					if(jse->number == 6)
-					{
-						buttons[8] = buttons[10] = 0;
-					}
+					buttons[JOYPAD_UP] = buttons[JOYPAD_DOWN] = 0;
 				}
 			}
-		}	/*	
-		else if(jse->type == JS_EVENT_INIT)
-		{
-			//printf("Initial state\n");
-		}
-		else
-		{
-			//printf("UNDEFINED STATE %d\n",jse->type);
 		}
-		*/
+	}	/*	
+	else if(jse->type == JS_EVENT_INIT)
+	{
+		//printf("Initial state\n");
 	}
-	
-	return 0;
+	else
+	{
+		//printf("UNDEFINED STATE %d\n",jse->type);
+	}
+	*/
 }
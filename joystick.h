@@ -28,6 +28,13 @@
 #define JS_EVENT_AXIS           0x02    /* joystick moved */
 #define JS_EVENT_INIT           0x80    /* initial state of device */
 
+#define JOYPAD_BUTTONS 12  /* botoes 0..7 do controle e 8..11 do direcional */
+#define JOYPAD_FIRE 0
+#define JOYPAD_UP 8
+#define JOYPAD_RIGHT 9
+#define JOYPAD_DOWN 10
+#define JOYPAD_LEFT 11
+
 
 struct js_event {
 	unsigned int time;	/* event timestamp in milliseconds */
@@ -41,5 +48,6 @@ extern int open_joystick();
 extern int read_joystick_event(struct js_event *jse);
 extern void close_joystick();
 int processaJoystick(int *buttons, struct js_event* jse);
+void decodeJoystickEvent(int *buttons, const struct js_event* jse);
 
 #endif
@@ -0,0 +1,39 @@
+/*
+ * texconv.cpp
+ *
+ *  Created on: 14/10/2026
+ *      Author: thaylo
+ */
+
+// Converte um BMP de 24 bits para o formato .tex (ver TexFile.h).
+// Uso: texconv entrada.bmp saida.tex
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Image.h"
+#include "TexFile.h"
+
+int main(int argc, char **argv)
+{
+	if(argc != 3)
+	{
+		printf("Uso: %s entrada.bmp saida.tex\n", argv[0]);
+		return 1;
+	}
+
+	Image img;
+	if(!ImageLoad(argv[1], &img)) return 1;
+
+	// ImageLoad entrega RGB; o .tex guarda a ordem do arquivo (BGR), que o GL aceita direto.
+	unsigned long total = img.sizeX*img.sizeY*3;
+	for(unsigned long i = 0; i < total; i += 3)
+	{
+		char aux = img.data[i];
+		img.data[i] = img.data[i+2];
+		img.data[i+2] = aux;
+	}
+
+	int ok = writeTexFile(argv[2], (const unsigned char *) img.data, img.sizeX, img.sizeY);
+	free(img.data);
+	return ok ? 0 : 1;
+}